@@ -676,6 +676,32 @@ static errr Term_xtra_gcu_event(int v)
 }
 
 
+#ifndef WINDOWS
+/*
+ * Wait for net input or a keypress on stdin (see Net_loop())
+ */
+static int gcu_wait_for_input(int net_fd, int msecs)
+{
+    fd_set readfds;
+    struct timeval timeout;
+
+    FD_ZERO(&readfds);
+    FD_SET(net_fd, &readfds);
+    FD_SET(STDIN_FILENO, &readfds);
+    timeout.tv_sec = msecs / 1000;
+    timeout.tv_usec = (msecs % 1000) * 1000;
+
+    /* Timeout, or interrupted (window resize) */
+    if (select(MAX(net_fd, STDIN_FILENO) + 1, &readfds, NULL, NULL, &timeout) <= 0) return 0;
+
+    /* Queue the keypress */
+    if (FD_ISSET(STDIN_FILENO, &readfds)) Term_xtra_gcu_event(0);
+
+    return FD_ISSET(net_fd, &readfds);
+}
+#endif
+
+
 static errr Term_xtra_gcu_flush(void)
 {
     int key;
@@ -1095,6 +1121,9 @@ errr init_gcu(int argc, char **argv)
     /* Activate hooks */
     plog_aux = hook_plog;
     quit_aux = hook_quit;
+#ifndef WINDOWS
+    wait_for_input = gcu_wait_for_input;
+#endif
 
 #ifdef WINDOWS
     /* Register a control handler */
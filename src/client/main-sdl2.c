@@ -182,18 +182,29 @@ static const char g_ascii_codepoints_for_cache[] =
     " !\"#$%&'()*+,-./0123456789:;<=>?"
     "@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_"
     "`abcdefghijklmnopqrstuvwxyz{|}~\x7f";
-/* Simple font cache. Only for ascii (which is like 99.99% (?) of what the game
- * displays, anyway) */
+/* Simple font cache. The ascii glyphs (which is like 99.99% (?) of what the
+ * game displays, anyway) are rendered when the font is made; the rest of the
+ * 8-bit glyphs (walls and floors of some fonts and pref files) are added to the
+ * same texture the first time they are drawn, so that every glyph is a copy
+ * from a single texture */
 #define ASCII_CACHE_SIZE \
         (N_ELEMENTS(g_ascii_codepoints_for_cache) - 1)
+#define GLYPH_CACHE_SIZE 256
+/* Limit the horizontal size of the texture for the cached font to
+ * avoid bumping into limits in the renderer. */
+#define GLYPH_CACHE_COLS 16
+enum glyph_state {
+    GLYPH_NOT_CACHED = 0,
+    GLYPH_CACHED,
+    /* the font can't render it */
+    GLYPH_MISSING
+};
 struct font_cache {
     SDL_Texture *texture;
     /* it wastes some space... so what? */
-    SDL_Rect rects[ASCII_CACHE_SIZE];
+    SDL_Rect rects[GLYPH_CACHE_SIZE];
+    uint8_t state[GLYPH_CACHE_SIZE];
 };
-/* 0 is also a valid codepoint, of course... that's just for finding bugs */
-#define IS_CACHED_ASCII_CODEPOINT(c) \
-        ((c) > 0 && (c) < ASCII_CACHE_SIZE)
 
 struct font {
     struct ttf ttf;
@@ -1046,46 +1057,166 @@ static void redraw_all_windows(struct my_app *a, bool dirty)
     }
 }
 
+/* renders a glyph in white into its cell of the font cache; restores the
+ * render target */
+static void cache_glyph(const struct sdlpui_window *window,
+        struct font *font, Uint8 index)
+{
+    SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
+
+    font->cache.state[index] = GLYPH_MISSING;
+
+    SDL_Surface *surface = TTF_RenderGlyph_Blended(font->ttf.handle,
+            index, white);
+    if (surface == NULL) {
+        return;
+    }
+
+    SDL_Texture *texture = SDL_CreateTextureFromSurface(window->renderer, surface);
+    if (texture != NULL) {
+        SDL_Texture *target = SDL_GetRenderTarget(window->renderer);
+        SDL_Rect src = {0, 0, surface->w, surface->h};
+        SDL_Rect dst = {
+            font->ttf.glyph.w * (index % GLYPH_CACHE_COLS),
+            font->ttf.glyph.h * (index / GLYPH_CACHE_COLS),
+            font->ttf.glyph.w,
+            font->ttf.glyph.h
+        };
+
+        crop_rects(&src, &dst);
+
+        SDL_SetRenderTarget(window->renderer, font->cache.texture);
+        SDL_RenderCopy(window->renderer, texture, &src, &dst);
+        SDL_SetRenderTarget(window->renderer, target);
+
+        font->cache.rects[index] = dst;
+        font->cache.state[index] = GLYPH_CACHED;
+
+        SDL_DestroyTexture(texture);
+    }
+
+    SDL_FreeSurface(surface);
+}
+
+/* returns the area of the font cache with the glyph, or NULL if the font
+ * can't render it */
+static const SDL_Rect *get_cached_glyph(const struct sdlpui_window *window,
+        struct font *font, uint16_t codepoint)
+{
+    /* the terminal hands out chars, so only the low byte matters;
+     * 0 is drawn as the blank glyph that starts the cache */
+    Uint8 index = (Uint8) codepoint;
+
+    if (font->cache.state[index] == GLYPH_NOT_CACHED) {
+        cache_glyph(window, font, index);
+    }
+    if (font->cache.state[index] == GLYPH_MISSING) {
+        return NULL;
+    }
+
+    return &font->cache.rects[index];
+}
+
 /* this function is typically called in a loop, so for efficiency it doesn't
  * SetRenderTarget; caller must do it (but it does SetTextureColorMod) */
 static void render_glyph_mono(const struct sdlpui_window *window,
-        const struct font *font, SDL_Texture *dst_texture,
+        struct font *font, SDL_Texture *dst_texture,
         int x, int y, const SDL_Color *fg, uint16_t codepoint)
 {
     if (codepoint == ' ') {
         return;
     }
 
+    const SDL_Rect *rect = get_cached_glyph(window, font, codepoint);
+    if (rect == NULL) {
+        return;
+    }
+
+    SDL_Rect src = *rect;
     SDL_Rect dst = {x, y, font->ttf.glyph.w, font->ttf.glyph.h};
 
-    if (IS_CACHED_ASCII_CODEPOINT(codepoint)) {
-        SDL_Rect src = font->cache.rects[codepoint];
+    crop_rects(&src, &dst);
 
-        crop_rects(&src, &dst);
+    SDL_SetTextureColorMod(font->cache.texture, fg->r, fg->g, fg->b);
 
-        SDL_SetTextureColorMod(font->cache.texture, fg->r, fg->g, fg->b);
+    SDL_RenderCopy(window->renderer, font->cache.texture, &src, &dst);
+}
 
-        SDL_RenderCopy(window->renderer,
-                font->cache.texture, &font->cache.rects[codepoint], &dst);
-    } else {
-        SDL_Surface *surface = TTF_RenderGlyph_Blended(font->ttf.handle,
-                (Uint8) codepoint, *fg);
-        if (surface == NULL) {
-            return;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+/* number of glyphs sent to the renderer at once */
+#define GLYPH_BATCH_SIZE 64
+#endif
+
+/* renders a row of n glyphs, one every "advance" pixels; like
+ * render_glyph_mono(), it doesn't SetRenderTarget. With SDL_RenderGeometry()
+ * the whole row is sent as one batch of textured quads (the color goes in the
+ * vertices instead of the color mod of the font cache) */
+static void render_glyphs_mono(const struct sdlpui_window *window,
+        struct font *font, int x, int y, int advance, const SDL_Color *fg,
+        const char *s, int n)
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    SDL_Vertex vertices[GLYPH_BATCH_SIZE * 4];
+    int indices[GLYPH_BATCH_SIZE * 6];
+    int count = 0;
+    int tex_w, tex_h;
+
+    SDL_QueryTexture(font->cache.texture, NULL, NULL, &tex_w, &tex_h);
+    SDL_SetTextureColorMod(font->cache.texture, 0xFF, 0xFF, 0xFF);
+
+    for (int i = 0; i < n; i++, x += advance) {
+        if (s[i] == ' ') {
+            continue;
         }
 
-        SDL_Texture *texture = SDL_CreateTextureFromSurface(window->renderer, surface);
-        assert(texture != NULL);
+        const SDL_Rect *rect = get_cached_glyph(window, font, (uint16_t) s[i]);
+        if (rect == NULL) {
+            continue;
+        }
 
-        SDL_Rect src = {0, 0, surface->w, surface->h};
+        SDL_Rect src = *rect;
+        SDL_Rect dst = {x, y, font->ttf.glyph.w, font->ttf.glyph.h};
 
         crop_rects(&src, &dst);
 
-        SDL_RenderCopy(window->renderer, texture, &src, &dst);
+        /* corners: top left, top right, bottom left, bottom right */
+        SDL_Vertex *v = &vertices[count * 4];
+        for (int k = 0; k < 4; k++) {
+            int right = k & 1;
+            int bottom = k >> 1;
 
-        SDL_FreeSurface(surface);
-        SDL_DestroyTexture(texture);
+            v[k].position.x = (float) (dst.x + right * dst.w);
+            v[k].position.y = (float) (dst.y + bottom * dst.h);
+            v[k].color = *fg;
+            v[k].color.a = 0xFF;
+            v[k].tex_coord.x = (float) (src.x + right * src.w) / tex_w;
+            v[k].tex_coord.y = (float) (src.y + bottom * src.h) / tex_h;
+        }
+
+        int *idx = &indices[count * 6];
+        idx[0] = count * 4;
+        idx[1] = count * 4 + 1;
+        idx[2] = count * 4 + 2;
+        idx[3] = count * 4 + 2;
+        idx[4] = count * 4 + 1;
+        idx[5] = count * 4 + 3;
+
+        if (++count == GLYPH_BATCH_SIZE) {
+            SDL_RenderGeometry(window->renderer, font->cache.texture,
+                    vertices, count * 4, indices, count * 6);
+            count = 0;
+        }
     }
+
+    if (count > 0) {
+        SDL_RenderGeometry(window->renderer, font->cache.texture,
+                vertices, count * 4, indices, count * 6);
+    }
+#else
+    for (int i = 0; i < n; i++, x += advance) {
+        render_glyph_mono(window, font, NULL, x, y, fg, (uint16_t) s[i]);
+    }
+#endif
 }
 
 static void render_cursor_aux(struct subwindow *subwindow, 
@@ -4917,13 +5048,8 @@ static errr term_text_hook(int col, int row, int n, uint16_t a, const char *s)
 
     render_fill_rect(subwindow->window, subwindow->texture, &rect, &bg);
 
-    rect.w = subwindow->font_width;
-    for (int i = 0; i < n; i++) {
-        render_glyph_mono(subwindow->window,
-                subwindow->font, subwindow->texture,
-                rect.x, rect.y, &fg, (uint16_t) s[i]);
-        rect.x += subwindow->font_width;
-    }
+    render_glyphs_mono(subwindow->window, subwindow->font,
+            rect.x, rect.y, subwindow->font_width, &fg, s, n);
 
     subwindow->window->dirty = true;
 
@@ -5300,16 +5426,15 @@ static void make_font_cache(const struct sdlpui_window *window,
 {
     const int glyph_w = font->ttf.glyph.w;
     const int glyph_h = font->ttf.glyph.h;
-    /*
-     * Limit the horizontal size of the texture for the cached font to
-     * avoid bumping into limits in the renderer.
-     */
-    const size_t ncol = 16;
+    const size_t ncol = GLYPH_CACHE_COLS;
 
+    /* room for all the 8-bit glyphs; the ones past ascii are cached
+     * when first drawn */
     font->cache.texture = make_subwindow_texture(window,
         (int)ncol * glyph_w,
-        (int)((ASCII_CACHE_SIZE + (ncol - 1)) / ncol) * glyph_h);
+        (int)((GLYPH_CACHE_SIZE + (ncol - 1)) / ncol) * glyph_h);
     assert(font->cache.texture != NULL);
+    memset(font->cache.state, GLYPH_NOT_CACHED, sizeof(font->cache.state));
         
     /* fill texture with white transparent pixels */
     SDL_Color white = {0xFF, 0xFF, 0xFF, 0};
@@ -5342,6 +5467,7 @@ static void make_font_cache(const struct sdlpui_window *window,
         SDL_RenderCopy(window->renderer, texture, &src, &dst);
 
         font->cache.rects[i] = dst;
+        font->cache.state[i] = GLYPH_CACHED;
 
         SDL_FreeSurface(surface);
         SDL_DestroyTexture(texture);
@@ -7050,6 +7176,32 @@ static void hook_plog(const char *str)
     return;
 }
 
+/*
+ * Wait for net input or an SDL event (see Net_loop())
+ *
+ * SDL has no file descriptor to wait on, so the socket is checked between short waits.
+ */
+static int wait_for_input_hook(int net_fd, int msecs)
+{
+    while (true) {
+        int slice = MIN(msecs, 5);
+
+        SetTimeout(0, 0);
+        if (SocketReadable(net_fd)) {
+            return 1;
+        }
+        if (msecs <= 0) {
+            return 0;
+        }
+        if (SDL_WaitEventTimeout(NULL, slice)) {
+            /* Queue the keypress */
+            (void) term_xtra_event(0);
+            return 0;
+        }
+        msecs -= slice;
+    }
+}
+
 errr init_sdl2(int argc, char **argv)
 {
     int i;
@@ -7067,6 +7219,7 @@ errr init_sdl2(int argc, char **argv)
     /* Activate hooks */
     plog_aux = hook_plog;
     quit_aux = quit_hook;
+    wait_for_input = wait_for_input_hook;
 
     /* Dump details about SDL that do not require SDL_Init(). */
 	if (g_app.print_sdl_details) {
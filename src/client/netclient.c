@@ -177,6 +177,24 @@ void do_keepalive(void)
 }
 
 
+/*
+ * Milliseconds until the next keepalive packet is due
+ *
+ * Capped at half a second, since update_ticks() must be called at least once per second.
+ */
+int keepalive_delay(void)
+{
+    int due;
+
+    update_ticks();
+    due = (last_sent + 11 - ticks) * 100;
+    if (due < 0) due = 0;
+    if (due > 500) due = 500;
+
+    return due;
+}
+
+
 void check_term_resize(bool main_win, int *cols, int *rows)
 {
     /* Window size bounds checking */
@@ -2346,6 +2364,69 @@ static void Term_big_queue_char_safe(int x, int y, uint16_t a, char c, uint16_t
 
 
 #define DUNGEON_RLE_MODE() (use_graphics? RLE_LARGE: RLE_CLASSIC)
+/*
+ * Check if a line of the main map can be drawn, and get the icky section offsets
+ */
+static bool map_line_drawable(int16_t y, int16_t cols, int16_t *xoff, int16_t *coff)
+{
+    bool draw = !player->screen_save_depth;
+
+    /* Shopping */
+    if (store_ctx) draw = false;
+
+    /* Hang on! Icky section! */
+    if (section_icky_row && (y < section_icky_row))
+    {
+        if (section_icky_col > 0) *xoff = section_icky_col;
+        if (section_icky_col < 0) *coff = section_icky_col;
+        if ((*xoff >= cols) || (cols - *coff <= 0)) draw = false;
+    }
+
+    /* Request a redraw if the line was icky */
+    if (!draw) request_redraw = true;
+
+    return draw;
+}
+
+
+/*
+ * Put columns [from, to) of a line of the main terminal to screen
+ */
+static void draw_map_line(uint8_t ch, int16_t y, cave_view_type *dest, cave_view_type *trn,
+    int from, int to, int16_t xoff)
+{
+    int i, x;
+    cave_view_type *scr_info, *trn_info;
+
+    /* For main map, apply vertical offset */
+    if (ch != PKT_MINI_MAP) y = (y - 1) * tile_height + 1;
+
+    /* Draw a character n times */
+    for (i = from; i < to; i++)
+    {
+        /* Index */
+        x = i + xoff;
+        scr_info = dest + x;
+        trn_info = trn + x;
+
+        /* Location */
+        x += COL_MAP;
+        if (ch != PKT_MINI_MAP) x += i * (tile_width - 1);
+
+        /* Draw the character */
+        Term_queue_char_safe(x, y, scr_info->a, scr_info->c, trn_info->a, trn_info->c);
+
+        if ((ch != PKT_MINI_MAP) && (tile_width * tile_height > 1))
+        {
+            uint16_t a_dummy = (use_graphics? COLOUR_WHITE: 0);
+            char c_dummy = (use_graphics? ' ': 0);
+
+            Term_big_queue_char_safe(x, y, scr_info->a, scr_info->c, a_dummy, c_dummy);
+        }
+    }
+}
+
+
 static int Receive_line_info(void)
 {
     uint8_t ch, r;
@@ -2419,21 +2500,7 @@ static int Receive_line_info(void)
                 if (n <= 0) return n;
             }
 
-            draw = !player->screen_save_depth;
-
-            /* Shopping */
-            if (store_ctx) draw = false;
-
-            /* Hang on! Icky section! */
-            if (section_icky_row && (y < section_icky_row))
-            {
-                if (section_icky_col > 0) xoff = section_icky_col;
-                if (section_icky_col < 0) coff = section_icky_col;
-                if ((xoff >= cols) || (cols - coff <= 0)) draw = false;
-            }
-
-            /* Request a redraw if the line was icky */
-            if (!draw) request_redraw = true;
+            draw = map_line_drawable(y, cols, &xoff, &coff);
         }
     }
 
@@ -2450,41 +2517,99 @@ static int Receive_line_info(void)
         /* Use MAIN terminal */
         else
         {
-            int i, x;
-            cave_view_type *scr_info, *trn_info;
-
             if (ch == PKT_MINI_MAP) Term->minimap_active = true;
 
             /* For mini-map, be sure the display gets cleared */
             if (ch == PKT_MINI_MAP) Term_erase(COL_MAP, y, 255);
 
-            /* For main map, apply vertical offset */
-            else y = (y - 1) * tile_height + 1;
+            draw_map_line(ch, y, dest, trn, 0, cols + coff, xoff);
+        }
+    }
 
-            /* Draw a character n times */
-            for (i = 0; i < cols + coff; i++)
-            {
-                /* Index */
-                x = i + xoff;
-                scr_info = dest + x;
-                trn_info = trn + x;
+    return 1;
+}
 
-                /* Location */
-                x += COL_MAP;
-                if (ch != PKT_MINI_MAP) x += i * (tile_width - 1);
 
-                /* Draw the character */
-                Term_queue_char_safe(x, y, scr_info->a, scr_info->c, trn_info->a, trn_info->c);
+/*
+ * Check that a span of grids fits in the main map buffers
+ */
+static bool map_span_valid(int y, int x, int len)
+{
+    return ((y >= 0) && (y < Setup.max_row + ROW_MAP + 1) && (x >= 0) && (len >= 0) &&
+        (x + len <= Setup.max_col + COL_MAP));
+}
 
-                if ((ch != PKT_MINI_MAP) && (tile_width * tile_height > 1))
-                {
-                    uint16_t a_dummy = (use_graphics? COLOUR_WHITE: 0);
-                    char c_dummy = (use_graphics? ' ': 0);
 
-                    Term_big_queue_char_safe(x, y, scr_info->a, scr_info->c, a_dummy, c_dummy);
-                }
-            }
+/*
+ * Receive the changed spans of a line of the main map
+ *
+ * The server only sends these when the main map is on the main terminal.
+ */
+static int Receive_line_delta(void)
+{
+    uint8_t ch, num, i;
+    int16_t y, cols, xoff = 0, coff = 0;
+    int16_t span_x[256], span_len[256];
+    int n, bytes_read;
+
+    /* Read line number and span count */
+    if ((n = Packet_scanf(&rbuf, "%b%hd%hd%b", &ch, &y, &cols, &num)) <= 0) return n;
+    bytes_read = 6;
+
+    /* Paranoia */
+    if (!map_span_valid(y, 0, cols))
+    {
+        errno = 0;
+        plog_fmt("Bad map line delta (line %d, %d columns)", y, cols);
+        return -1;
+    }
+
+    /* Decode each span */
+    for (i = 0; i < num; i++)
+    {
+        if ((n = Packet_scanf(&rbuf, "%hd%hd", &span_x[i], &span_len[i])) <= 0)
+        {
+            /* Rollback the socket buffer */
+            Sockbuf_rollback(&rbuf, bytes_read);
+
+            /* Packet isn't complete, graceful failure */
+            return n;
+        }
+        bytes_read += 4;
+
+        /* Paranoia */
+        if ((span_x[i] < 0) || (span_len[i] < 0) || (span_x[i] + span_len[i] > cols))
+        {
+            errno = 0;
+            plog_fmt("Bad map line delta span (%d, %d) on line %d", span_x[i], span_len[i], y);
+            return -1;
+        }
+
+        /* Decode the secondary attr/char stream */
+        if (use_graphics)
+        {
+            n = rle_decode(&rbuf, player->trn_info[y] + span_x[i], span_len[i], RLE_LARGE,
+                &bytes_read);
+            if (n <= 0) return n;
         }
+
+        /* Decode the attr/char stream */
+        n = rle_decode(&rbuf, player->scr_info[y] + span_x[i], span_len[i], DUNGEON_RLE_MODE(),
+            &bytes_read);
+        if (n <= 0) return n;
+    }
+
+    /* Check the max line count */
+    last_line_info = y;
+
+    /* Put data to screen */
+    if (!map_line_drawable(y, cols, &xoff, &coff)) return 1;
+    for (i = 0; i < num; i++)
+    {
+        int from = MAX(span_x[i] - xoff, 0);
+        int to = MIN(span_x[i] + span_len[i] - xoff, cols + coff);
+
+        draw_map_line(PKT_LINE_INFO, y, player->scr_info[y], player->trn_info[y], from, to, xoff);
     }
 
     return 1;
@@ -2568,14 +2693,59 @@ static int Receive_show_floor(void)
 }
 
 
+/*
+ * Put a grid of the main map to screen, or queue it for later if the map is covered
+ */
+static void draw_map_char(uint8_t x, uint8_t y, uint16_t a, char c, uint16_t tap, char tcp)
+{
+    uint8_t x_off;
+    bool draw = true;
+    int n;
+
+    /* Manipulate offset */
+    x_off = x + COL_MAP;
+
+    if (player->screen_save_depth || section_icky_row || store_ctx) draw = false;
+    if (section_icky_row)
+    {
+        if (y >= section_icky_row) draw = true;
+        else if ((section_icky_col > 0) && (x_off >= section_icky_col)) draw = true;
+        else if ((section_icky_col < 0) && (x_off >= 0 - section_icky_col)) draw = true;
+    }
+
+    if (draw)
+    {
+        x_off += x * (tile_width - 1);
+        y = (y - 1) * tile_height + 1;
+
+        Term_queue_char_safe(x_off, y, a, c, tap, tcp);
+        if (tile_width * tile_height > 1)
+        {
+            uint16_t a_dummy = (use_graphics? COLOUR_WHITE: 0);
+            char c_dummy = (use_graphics? ' ': 0);
+
+            Term_big_queue_char_safe(x_off, y, a, c, a_dummy, c_dummy);
+        }
+    }
+
+    /* Queue for later */
+    else
+    {
+        n = Packet_printf(&qbuf, "%b%b%b%hu%c", (unsigned)PKT_CHAR, (unsigned)x,
+            (unsigned)y, (unsigned)a, (int)c);
+        if ((n > 0) && use_graphics)
+            Packet_printf(&qbuf, "%hu%c", (unsigned)tap, (int)tcp);
+    }
+}
+
+
 static int Receive_char(void)
 {
     int n;
     uint8_t ch;
-    uint8_t x, y, x_off;
+    uint8_t x, y;
     char c, tcp;
     uint16_t a, tap;
-    bool draw = true;
     int bytes_read;
 
     tap = tcp = c = a = x = y = 0;
@@ -2619,39 +2789,82 @@ static int Receive_char(void)
         player->trn_info[y][x].c = tcp;
     }
 
-    /* Manipulate offset */
-    x_off = x + COL_MAP;
+    draw_map_char(x, y, a, c, tap, tcp);
 
-    if (player->screen_save_depth || section_icky_row || store_ctx) draw = false;
-    if (section_icky_row)
+    return 1;
+}
+
+
+/*
+ * Receive a batch of main map grids
+ *
+ * The server sends these instead of PKT_CHAR when the main map is on the main terminal.
+ */
+static int Receive_chars(void)
+{
+    int n, i, bytes_read;
+    uint8_t ch;
+    int16_t num;
+    uint8_t span_x[MAX_CHAR_SPANS], span_y[MAX_CHAR_SPANS], span_len[MAX_CHAR_SPANS];
+
+    if ((n = Packet_scanf(&rbuf, "%b%hd", &ch, &num)) <= 0) return n;
+    bytes_read = 3;
+
+    /* Paranoia */
+    if ((num < 0) || (num > MAX_CHAR_SPANS))
     {
-        if (y >= section_icky_row) draw = true;
-        else if ((section_icky_col > 0) && (x_off >= section_icky_col)) draw = true;
-        else if ((section_icky_col < 0) && (x_off >= 0 - section_icky_col)) draw = true;
+        errno = 0;
+        plog_fmt("Bad map grid span count (%d)", num);
+        return -1;
     }
 
-    if (draw)
+    /* Decode each span */
+    for (i = 0; i < num; i++)
     {
-        x_off += x * (tile_width - 1);
-        y = (y - 1) * tile_height + 1;
+        if ((n = Packet_scanf(&rbuf, "%b%b%b", &span_x[i], &span_y[i], &span_len[i])) <= 0)
+        {
+            /* Rollback the socket buffer */
+            Sockbuf_rollback(&rbuf, bytes_read);
 
-        Term_queue_char_safe(x_off, y, a, c, tap, tcp);
-        if (tile_width * tile_height > 1)
+            /* Packet isn't complete, graceful failure */
+            return n;
+        }
+        bytes_read += 3;
+
+        /* Paranoia */
+        if (!map_span_valid(span_y[i], span_x[i], span_len[i]))
         {
-            uint16_t a_dummy = (use_graphics? COLOUR_WHITE: 0);
-            char c_dummy = (use_graphics? ' ': 0);
+            errno = 0;
+            plog_fmt("Bad map grid span (%d, %d, %d)", span_x[i], span_y[i], span_len[i]);
+            return -1;
+        }
 
-            Term_big_queue_char_safe(x_off, y, a, c, a_dummy, c_dummy);
+        /* Decode the secondary attr/char stream */
+        if (use_graphics)
+        {
+            n = rle_decode(&rbuf, player->trn_info[span_y[i]] + span_x[i], span_len[i], RLE_LARGE,
+                &bytes_read);
+            if (n <= 0) return n;
         }
+
+        /* Decode the attr/char stream */
+        n = rle_decode(&rbuf, player->scr_info[span_y[i]] + span_x[i], span_len[i],
+            DUNGEON_RLE_MODE(), &bytes_read);
+        if (n <= 0) return n;
     }
 
-    /* Queue for later */
-    else
+    /* Put data to screen */
+    for (i = 0; i < num; i++)
     {
-        n = Packet_printf(&qbuf, "%b%b%b%hu%c", (unsigned)ch, (unsigned)x,
-            (unsigned)y, (unsigned)a, (int)c);
-        if ((n > 0) && use_graphics)
-            Packet_printf(&qbuf, "%hu%c", (unsigned)tap, (int)tcp);
+        int x;
+
+        for (x = span_x[i]; x < span_x[i] + span_len[i]; x++)
+        {
+            cave_view_type *scr = &player->scr_info[span_y[i]][x];
+            cave_view_type *trn = &player->trn_info[span_y[i]][x];
+
+            draw_map_char(x, span_y[i], scr->a, scr->c, trn->a, trn->c);
+        }
     }
 
     return 1;
@@ -6499,7 +6712,21 @@ int Net_packet(void)
         if ((cur_type <= PKT_UNDEFINED) || (cur_type >= PKT_MAX)) cur_type = PKT_UNDEFINED;
 
         old_ptr = rbuf.ptr;
-        if ((result = (*receive_tbl[cur_type])()) <= 0)
+
+        /*
+         * Packets decoded by rle_decode() are read in several parts and rolled back if one is
+         * missing: don't read from the socket in the middle of them, since that would discard
+         * the bytes already consumed
+         */
+        if ((cur_type == PKT_LINE_INFO) || (cur_type == PKT_MINI_MAP) ||
+            (cur_type == PKT_LINE_DELTA) || (cur_type == PKT_CHARS) ||
+            (cur_type == PKT_OBJFLAGS) || (cur_type == PKT_FULLMAP))
+        {
+            SET_BIT(rbuf.state, SOCKBUF_LOCK);
+        }
+        result = (*receive_tbl[cur_type])();
+        CLR_BIT(rbuf.state, SOCKBUF_LOCK);
+        if (result <= 0)
         {
             if (result == -1)
             {
@@ -1280,6 +1280,29 @@ const char *extract_file_name(const char *s)
 }
 
 
+/*
+ * Wait for net input or a keypress, for at most "msecs" milliseconds
+ *
+ * Frontends that can block on their input source set wait_for_input(), which returns true
+ * when there is net input and queues any keypress in the current term. Otherwise keypresses
+ * are polled every millisecond.
+ */
+int (*wait_for_input)(int net_fd, int msecs) = NULL;
+
+
+static int net_wait(int net_fd, int msecs)
+{
+    /* Keys are waiting to be processed: just poll */
+    if (Term->key_head != Term->key_tail) msecs = 1;
+
+    if (wait_for_input) return wait_for_input(net_fd, msecs);
+
+    /* Wait for .001 sec, or until there is net input */
+    SetTimeout(0, 1000);
+    return SocketReadable(net_fd);
+}
+
+
 /*
  * Loop, looking for net input and responding to keypresses.
  */
@@ -1287,7 +1310,7 @@ ui_event Net_loop(errr (*inkey_handler)(ui_event*, bool, bool),
     void (*callback_begin)(ui_event*), void (*callback_end)(bool), char scan_cutoff, bool inmap)
 {
     ui_event ke = EVENT_EMPTY;
-    int net_fd;
+    int net_fd, readable;
     int w = 0;
 
     /* Acquire and save maximum file descriptor */
@@ -1355,14 +1378,15 @@ ui_event Net_loop(errr (*inkey_handler)(ui_event*, bool, bool),
             break;
         }
 
-        /* Wait for .001 sec, or until there is net input */
-        SetTimeout(0, 1000);
-
-        /* Update the screen */
+        /* Update the screen (does nothing if nothing changed) */
         Term_fresh();
 
+        /* Wait for net input, a keypress or the next keepalive */
+        readable = net_wait(net_fd, ((scan_cutoff != SCAN_OFF)? 1: keepalive_delay()));
+
         /* Parse net input if we got any */
-        if (SocketReadable(net_fd) && (Net_input() == -1))
+        SetTimeout(0, 0);
+        if (readable && (Net_input() == -1))
         {
             ke.type = EVT_ERROR;
             send_quit = false;
@@ -75,6 +75,7 @@ extern bool askfor_aux(char *buf, int len, keypress_handler keypress_h);
 extern int askfor_ex(char *buf, int len, keypress_handler keypress_h, bool priv);
 extern void textui_input_init(void);
 extern bool (*get_file)(const char *suggested_name, char *path, size_t len);
+extern int (*wait_for_input)(int net_fd, int msecs);
 extern void flush_now(void);
 extern void flush_hack(void);
 extern int target_dir(struct keypress ch);
@@ -43,7 +43,7 @@ bool beta_version(void)
 #define VERSION_MAJOR   1
 #define VERSION_MINOR   6
 #define VERSION_PATCH   2
-#define VERSION_EXTRA   4
+#define VERSION_EXTRA   5
 
 
 uint16_t current_version(void)
@@ -119,6 +119,28 @@
  * Note: I build PWMAngband with C++ Builder, which DOES NOT have stdbool
  */
 
+/*
+ * C99 "inline" keyword (C++ Builder and old versions of Visual C++ only have their own)
+ */
+#if defined(__BORLANDC__) && !defined(__clang__)
+# define INLINE __inline
+#elif defined(_MSC_VER) && (_MSC_VER < 1900)
+# define INLINE __inline
+#else
+# define INLINE inline
+#endif
+
+/*
+ * Thread-local storage (each thread gets its own copy of the variable)
+ */
+#if defined(_MSC_VER) || (defined(__BORLANDC__) && !defined(__clang__))
+# define THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+# define THREAD_LOCAL __thread
+#else
+# define THREAD_LOCAL
+#endif
+
 /*
  * Every system seems to use its own symbol as a path separator.
  */
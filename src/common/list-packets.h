@@ -162,3 +162,6 @@ PKT(CHANNEL, undefined, channel, undefined, channel)
 PKT(HISTORY, undefined, history, undefined, history)
 PKT(AUTOINSCR, autoinscriptions, undefined, undefined, autoinscriptions)
 PKT(PLAY_SETUP, undefined, undefined, play_setup, undefined)
+/* Packets added in 1.6.2.5, only sent to clients that know them */
+PKT(LINE_DELTA, undefined, undefined, undefined, line_delta)
+PKT(CHARS, undefined, undefined, undefined, chars)
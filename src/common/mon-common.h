@@ -359,6 +359,11 @@ struct monster
     struct loc old_grid;                /* Previous monster location */
     struct monster *closest_target;     /* The target closest to this monster (transient) */
     int32_t damhp;                      /* Sustainable damage from damaging terrain */
+    uint32_t dormant_steps;             /* Player steps on the level that wake a dormant monster */
+    struct loc cover_grid;              /* Last safe or hiding place found (transient) */
+    struct loc cover_from;              /* Player location when it was found (transient) */
+    int32_t cover_player;               /* Player it was found against (transient) */
+    uint8_t cover_type;                 /* Type of place (transient) */
 };
 
 /*
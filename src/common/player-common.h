@@ -515,6 +515,10 @@ struct player_upkeep
     bool skip_redraw_equip;         /* Skip redraw_equip object */
     struct object *redraw_inven;    /* Single inventory object to redraw */
     bool skip_redraw_inven;         /* Skip redraw_inven object */
+    struct item_cache *item_cache;  /* Cached item descriptions, by item index */
+    int item_cache_size;
+    uint32_t item_stamp;            /* Bumped when all item descriptions may have changed */
+    bool redraw_panel;              /* Redraw map after a panel change */
 };
 
 /*
@@ -567,6 +571,7 @@ struct player_square
     int light;
     struct object *obj;
     struct trap *trap;
+    bool listed;            /* Grid is in the list of known piles */
 };
 
 struct heatmap
@@ -580,8 +585,12 @@ struct player_cave
     int height;
     int width;
     struct player_square **squares;
+    struct mem_arena *arena;    /* Square info flags */
     struct heatmap noise;
     struct heatmap scent;
+    struct loc *piles;          /* Grids that hold (or held) a known pile */
+    int num_piles;
+    int max_piles;
     bool allocated;
 };
 
@@ -610,6 +619,15 @@ typedef struct
     char c; /* ASCII character */
 } cave_view_type;
 
+/* Cached glyphs of a grid (see map_glyph()) */
+struct glyph_cache
+{
+    uint32_t stamp; /* Version stamp of the grid */
+    uint32_t epoch; /* Player display epoch (0 if invalid) */
+    cave_view_type scr;
+    cave_view_type trn;
+};
+
 /* Information about a "hostility" */
 typedef struct _hostile_type
 {
@@ -787,6 +805,15 @@ struct player
     struct loc old_offset_grid;
     cave_view_type **scr_info;
     cave_view_type **trn_info;
+    cave_view_type **map_sent_scr;          /* Main map as last sent to the client */
+    cave_view_type **map_sent_trn;
+    bool map_sent_valid;                    /* Client holds map_sent_scr/trn (deltas allowed) */
+    int16_t map_sent_cols;                  /* Screen width of the last keyframe */
+    uint16_t map_sent_frames;               /* Frames sent since the last keyframe */
+    bitflag **map_dirty;                    /* Grids waiting to be sent (PKT_CHARS) */
+    bitflag *map_dirty_rows;                /* Rows with grids waiting to be sent */
+    struct glyph_cache **glyph_cache;       /* Cached glyphs of the current level */
+    uint32_t glyph_epoch;                   /* Bumped when all cached glyphs are stale */
     char msg_log[MAX_MSG_HIST][NORMAL_WID]; /* Message history log */
     int16_t msg_hist_ptr;                   /* Where will the next message be stored */
     uint8_t last_dir;                       /* Last direction moved (used for swapping places) */
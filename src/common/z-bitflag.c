@@ -22,43 +22,48 @@
 
 
 /*
- * Tests if a flag is "on" in a bitflag set.
+ * Set operations work on whole machine words, then finish byte by byte.
  *
- * true is returned when `flag` is on in `flags`, and false otherwise.
- * The flagset size is supplied in `size`.
+ * Words are loaded and stored with memcpy() so that bitflag arrays don't need any particular
+ * alignment; compilers turn these into single moves.
  */
-bool flag_has(const bitflag *flags, const size_t size, const int flag)
-{
-    const size_t flag_offset = FLAG_OFFSET(flag);
-    const int flag_binary = FLAG_BINARY(flag);
+typedef uint64_t flag_word;
 
-    if (flag == FLAG_END) return false;
 
-    my_assert(flag_offset < size);
+#define FLAG_WORD_SIZE  sizeof(flag_word)
 
-    if (flags[flag_offset] & flag_binary) return true;
 
-    return false;
+static flag_word flag_load(const bitflag *flags)
+{
+    flag_word w;
+
+    memcpy(&w, flags, sizeof(w));
+    return w;
 }
 
 
-bool flag_has_dbg(const bitflag *flags, const size_t size, const int flag, const char *fi,
-    const char *fl)
+static void flag_store(bitflag *flags, flag_word w)
 {
-    const size_t flag_offset = FLAG_OFFSET(flag);
-    const int flag_binary = FLAG_BINARY(flag);
+    memcpy(flags, &w, sizeof(w));
+}
 
-    if (flag == FLAG_END) return false;
 
-    if (flag_offset >= size)
+/*
+ * Reports an out of bounds flag access (debug builds only).
+ */
+void flag_bounds_error(const char *func, const char *fi, const char *fl, const int flag,
+    const size_t size)
+{
+    if (fi && fl)
     {
-        quit_fmt("Error in flag_has(%s, %s): FlagID[%d] Size[%u] FlagOff[%u] FlagBV[%d]",
-            fi, fl, flag, (unsigned int)size, (unsigned int)flag_offset, flag_binary);
+        quit_fmt("Error in %s(%s, %s): FlagID[%d] Size[%u] FlagOff[%u] FlagBV[%d]", func, fi, fl,
+            flag, (unsigned int)size, (unsigned int)FLAG_OFFSET(flag), FLAG_BINARY(flag));
+    }
+    else
+    {
+        quit_fmt("Error in %s(): FlagID[%d] Size[%u] FlagOff[%u] FlagBV[%d]", func, flag,
+            (unsigned int)size, (unsigned int)FLAG_OFFSET(flag), FLAG_BINARY(flag));
     }
-
-    if (flags[flag_offset] & flag_binary) return true;
-
-    return false;
 }
 
 
@@ -80,6 +85,13 @@ int flag_next(const bitflag *flags, const size_t size, const int flag)
         flag_offset = FLAG_OFFSET(f);
         flag_binary = FLAG_BINARY(f);
 
+        /* Skip empty bytes */
+        if (!flags[flag_offset])
+        {
+            f += FLAG_WIDTH - 1 - (f - FLAG_START) % FLAG_WIDTH;
+            continue;
+        }
+
         if (flags[flag_offset] & flag_binary) return f;
     }
 
@@ -94,14 +106,29 @@ int flag_next(const bitflag *flags, const size_t size, const int flag)
  */
 int flag_count(const bitflag *flags, const size_t size)
 {
-    size_t i, j;
+    size_t i = 0;
     int count = 0;
 
-    for (i = 0; i < size; i++)
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
     {
-        for (j = 1; j <= FLAG_WIDTH; j++)
+        flag_word w = flag_load(flags + i);
+
+        /* Clear the lowest set bit until none is left */
+        while (w)
         {
-            if (flags[i] & FLAG_BINARY(j)) count++;
+            w &= w - 1;
+            count++;
+        }
+    }
+
+    for (; i < size; i++)
+    {
+        bitflag b = flags[i];
+
+        while (b)
+        {
+            b &= b - 1;
+            count++;
         }
     }
 
@@ -117,9 +144,12 @@ int flag_count(const bitflag *flags, const size_t size)
  */
 bool flag_is_empty(const bitflag *flags, const size_t size)
 {
-    size_t i;
+    size_t i = 0;
+
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
+        if (flag_load(flags + i)) return false;
 
-    for (i = 0; i < size; i++)
+    for (; i < size; i++)
         if (flags[i] > 0) return false;
 
     return true;
@@ -134,9 +164,12 @@ bool flag_is_empty(const bitflag *flags, const size_t size)
  */
 bool flag_is_full(const bitflag *flags, const size_t size)
 {
-    size_t i;
+    size_t i = 0;
+
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
+        if (flag_load(flags + i) != (flag_word) -1) return false;
 
-    for (i = 0; i < size; i++)
+    for (; i < size; i++)
         if (flags[i] != (bitflag) -1) return false;
 
     return true;
@@ -151,9 +184,12 @@ bool flag_is_full(const bitflag *flags, const size_t size)
  */
 bool flag_is_inter(const bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-    size_t i;
+    size_t i = 0;
 
-    for (i = 0; i < size; i++)
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
+        if (flag_load(flags1 + i) & flag_load(flags2 + i)) return true;
+
+    for (; i < size; i++)
         if (flags1[i] & flags2[i]) return true;
 
     return false;
@@ -168,9 +204,12 @@ bool flag_is_inter(const bitflag *flags1, const bitflag *flags2, const size_t si
  */
 bool flag_is_subset(const bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-    size_t i;
+    size_t i = 0;
+
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
+        if (~flag_load(flags1 + i) & flag_load(flags2 + i)) return false;
 
-    for (i = 0; i < size; i++)
+    for (; i < size; i++)
         if (~flags1[i] & flags2[i]) return false;
 
     return true;
@@ -189,70 +228,6 @@ bool flag_is_equal(const bitflag *flags1, const bitflag *flags2, const size_t si
 }
 
 
-/*
- * Sets one bitflag in a bitfield.
- *
- * The bitflag identified by `flag` is set in `flags`. The bitfield size is
- * supplied in `size`.  true is returned when changes were made, false
- * otherwise.
- */
-bool flag_on(bitflag *flags, const size_t size, const int flag)
-{
-    const size_t flag_offset = FLAG_OFFSET(flag);
-    const int flag_binary = FLAG_BINARY(flag);
-
-    my_assert(flag_offset < size);
-
-    if (flags[flag_offset] & flag_binary) return false;
-
-    flags[flag_offset] |= flag_binary;
-
-    return true;
-}
-
-
-bool flag_on_dbg(bitflag *flags, const size_t size, const int flag, const char *fi,
-    const char *fl)
-{
-    const size_t flag_offset = FLAG_OFFSET(flag);
-    const int flag_binary = FLAG_BINARY(flag);
-
-    if (flag_offset >= size)
-    {
-        quit_fmt("Error in flag_on(%s, %s): FlagID[%d] Size[%u] FlagOff[%u] FlagBV[%d]",
-            fi, fl, flag, (unsigned int)size, (unsigned int)flag_offset, flag_binary);
-    }
-
-    if (flags[flag_offset] & flag_binary) return false;
-
-    flags[flag_offset] |= flag_binary;
-
-    return true;
-}
-
-
-/*
- * Clears one flag in a bitfield.
- *
- * The bitflag identified by `flag` is cleared in `flags`. The bitfield size
- * is supplied in `size`.  true is returned when changes were made, false
- * otherwise.
- */
-bool flag_off(bitflag *flags, const size_t size, const int flag)
-{
-    const size_t flag_offset = FLAG_OFFSET(flag);
-    const int flag_binary = FLAG_BINARY(flag);
-
-    my_assert(flag_offset < size);
-
-    if (!(flags[flag_offset] & flag_binary)) return false;
-
-    flags[flag_offset] &= ~flag_binary;
-
-    return true;
-}
-
-
 /*
  * Clears all flags in a bitfield.
  *
@@ -282,9 +257,12 @@ void flag_setall(bitflag *flags, const size_t size)
  */
 void flag_negate(bitflag *flags, const size_t size)
 {
-    size_t i;
-    
-    for (i = 0; i < size; i++)
+    size_t i = 0;
+
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
+        flag_store(flags + i, ~flag_load(flags + i));
+
+    for (; i < size; i++)
         flags[i] = ~flags[i];
 }
 
@@ -310,10 +288,20 @@ void flag_copy(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_union(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-    size_t i;
+    size_t i = 0;
     bool delta = false;
 
-    for (i = 0; i < size; i++)
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
+    {
+        flag_word w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
+
+        /* !flag_is_subset() */
+        if (~w1 & w2) delta = true;
+
+        flag_store(flags1 + i, w1 | w2);
+    }
+
+    for (; i < size; i++)
     {
         /* !flag_is_subset() */
         if (~flags1[i] & flags2[i]) delta = true;
@@ -334,10 +322,20 @@ bool flag_union(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_inter(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-    size_t i;
+    size_t i = 0;
     bool delta = false;
 
-    for (i = 0; i < size; i++)
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
+    {
+        flag_word w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
+
+        /* !flag_is_equal() */
+        if (w1 != w2) delta = true;
+
+        flag_store(flags1 + i, w1 & w2);
+    }
+
+    for (; i < size; i++)
     {
         /* !flag_is_equal() */
         if (!(flags1[i] == flags2[i])) delta = true;
@@ -358,10 +356,20 @@ bool flag_inter(bitflag *flags1, const bitflag *flags2, const size_t size)
  */
 bool flag_diff(bitflag *flags1, const bitflag *flags2, const size_t size)
 {
-    size_t i;
+    size_t i = 0;
     bool delta = false;
 
-    for (i = 0; i < size; i++)
+    for (; i + FLAG_WORD_SIZE <= size; i += FLAG_WORD_SIZE)
+    {
+        flag_word w1 = flag_load(flags1 + i), w2 = flag_load(flags2 + i);
+
+        /* flag_is_inter() */
+        if (w1 & w2) delta = true;
+
+        flag_store(flags1 + i, w1 & ~w2);
+    }
+
+    for (; i < size; i++)
     {
         /* flag_is_inter() */
         if (flags1[i] & flags2[i]) delta = true;
@@ -573,10 +581,12 @@ bool flags_mask(bitflag *flags, const size_t size, ...)
     va_list args;
     bool delta = false;
 
-    bitflag *mask;
+    bitflag mask_buf[32];
+    bitflag *mask = mask_buf;
 
-    /* Build the mask */
-    mask = mem_zalloc(size * sizeof(bitflag));
+    /* Build the mask (on the stack for the usual flag sets) */
+    if (size > N_ELEMENTS(mask_buf)) mask = mem_zalloc(size * sizeof(bitflag));
+    else memset(mask_buf, 0, sizeof(mask_buf));
 
     va_start(args, size);
 
@@ -589,7 +599,7 @@ bool flags_mask(bitflag *flags, const size_t size, ...)
     delta = flag_inter(flags, mask, size);
 
     /* Free the mask */
-    mem_free(mask);
+    if (mask != mask_buf) mem_free(mask);
 
     return delta;
 }
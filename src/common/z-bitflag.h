@@ -42,9 +42,8 @@ typedef uint8_t bitflag;
  */
 #define FLAG_BINARY(id)   (1 << ((id) - FLAG_START) % FLAG_WIDTH)
 
-extern bool flag_has(const bitflag *flags, const size_t size, const int flag);
-extern bool flag_has_dbg(const bitflag *flags, const size_t size, const int flag,
-    const char *fi, const char *fl);
+extern void flag_bounds_error(const char *func, const char *fi, const char *fl, const int flag,
+    const size_t size);
 extern int flag_next(const bitflag *flags, const size_t size, const int flag);
 extern int flag_count(const bitflag *flags, const size_t size);
 extern bool flag_is_empty(const bitflag *flags, const size_t size);
@@ -52,10 +51,6 @@ extern bool flag_is_full(const bitflag *flags, const size_t size);
 extern bool flag_is_inter(const bitflag *flags1, const bitflag *flags2, const size_t size);
 extern bool flag_is_subset(const bitflag *flags1, const bitflag *flags2, const size_t size);
 extern bool flag_is_equal(const bitflag *flags1, const bitflag *flags2, const size_t size);
-extern bool flag_on(bitflag *flags, const size_t size, const int flag);
-extern bool flag_on_dbg(bitflag *flags, const size_t size, const int flag, const char *fi,
-    const char *fl);
-extern bool flag_off(bitflag *flags, const size_t size, const int flag);
 extern void flag_wipe(bitflag *flags, const size_t size);
 extern void flag_setall(bitflag *flags, const size_t size);
 extern void flag_negate(bitflag *flags, const size_t size);
@@ -70,4 +65,99 @@ extern bool flags_set(bitflag *flags, const size_t size, ...);
 extern void flags_init(bitflag *flags, const size_t size, ...);
 extern bool flags_mask(bitflag *flags, const size_t size, ...);
 
+/*
+ * Single flag operations
+ *
+ * These are called everywhere (sqinfo_has(), of_has(), rf_has()...) with a constant size,
+ * so they are defined here to let the compiler inline them. The bounds check is only done
+ * in debug builds.
+ */
+#ifdef NDEBUG
+#define FLAG_CHECK_BOUNDS(func, fi, fl, flag, size) ((void)0)
+#else
+#define FLAG_CHECK_BOUNDS(func, fi, fl, flag, size) \
+    do \
+    { \
+        if ((size_t)FLAG_OFFSET(flag) >= (size)) flag_bounds_error(func, fi, fl, flag, size); \
+    } while (0)
+#endif
+
+
+/*
+ * Tests if a flag is "on" in a bitflag set.
+ *
+ * true is returned when `flag` is on in `flags`, and false otherwise.
+ * The flagset size is supplied in `size`.
+ */
+static INLINE bool flag_has(const bitflag *flags, const size_t size, const int flag)
+{
+    if (flag == FLAG_END) return false;
+
+    FLAG_CHECK_BOUNDS("flag_has", NULL, NULL, flag, size);
+
+    return ((flags[FLAG_OFFSET(flag)] & FLAG_BINARY(flag)) != 0);
+}
+
+
+static INLINE bool flag_has_dbg(const bitflag *flags, const size_t size, const int flag,
+    const char *fi, const char *fl)
+{
+    if (flag == FLAG_END) return false;
+
+    FLAG_CHECK_BOUNDS("flag_has", fi, fl, flag, size);
+
+    return ((flags[FLAG_OFFSET(flag)] & FLAG_BINARY(flag)) != 0);
+}
+
+
+/*
+ * Sets one bitflag in a bitfield.
+ *
+ * The bitflag identified by `flag` is set in `flags`. The bitfield size is
+ * supplied in `size`.  true is returned when changes were made, false
+ * otherwise.
+ */
+static INLINE bool flag_on(bitflag *flags, const size_t size, const int flag)
+{
+    FLAG_CHECK_BOUNDS("flag_on", NULL, NULL, flag, size);
+
+    if (flags[FLAG_OFFSET(flag)] & FLAG_BINARY(flag)) return false;
+
+    flags[FLAG_OFFSET(flag)] |= FLAG_BINARY(flag);
+
+    return true;
+}
+
+
+static INLINE bool flag_on_dbg(bitflag *flags, const size_t size, const int flag,
+    const char *fi, const char *fl)
+{
+    FLAG_CHECK_BOUNDS("flag_on", fi, fl, flag, size);
+
+    if (flags[FLAG_OFFSET(flag)] & FLAG_BINARY(flag)) return false;
+
+    flags[FLAG_OFFSET(flag)] |= FLAG_BINARY(flag);
+
+    return true;
+}
+
+
+/*
+ * Clears one flag in a bitfield.
+ *
+ * The bitflag identified by `flag` is cleared in `flags`. The bitfield size
+ * is supplied in `size`.  true is returned when changes were made, false
+ * otherwise.
+ */
+static INLINE bool flag_off(bitflag *flags, const size_t size, const int flag)
+{
+    FLAG_CHECK_BOUNDS("flag_off", NULL, NULL, flag, size);
+
+    if (!(flags[FLAG_OFFSET(flag)] & FLAG_BINARY(flag))) return false;
+
+    flags[FLAG_OFFSET(flag)] &= ~FLAG_BINARY(flag);
+
+    return true;
+}
+
 #endif
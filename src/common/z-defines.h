@@ -72,6 +72,11 @@
 #define RLE_CLASSIC 1
 #define RLE_LARGE 2
 
+/*
+ * Maximum number of grid spans in a PKT_CHARS packet
+ */
+#define MAX_CHAR_SPANS  255
+
 /*
  * Party commands
  */
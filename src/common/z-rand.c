@@ -31,6 +31,9 @@
  *
  * This code provides both a "quick" random number generator (4 bytes of
  * state), and a "complex" random number generator (128 + 4 bytes of state).
+ * Both are kept in a "rand_state" stream; every thread has a default stream
+ * and can switch to another one with Rand_state_use(), so that threads (or
+ * levels) never share a stream by accident.
  *
  * The complex RNG (used for most game entropy) is provided by the WELL1024a
  * algorithm, used with permission. See below for copyright information
@@ -59,24 +62,15 @@
 #define MAT0NEG(t, v) (v ^ (v << (-(t))))
 #define Identity(v) (v)
 
-uint32_t state_i = 0;
-uint32_t STATE[RAND_DEG] =
-{
-    0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0,
-    0, 0, 0, 0, 0, 0, 0, 0
-};
-
-#define V0    STATE[state_i]
-#define VM1   STATE[(state_i + M1) & 0x0000001fU]
-#define VM2   STATE[(state_i + M2) & 0x0000001fU]
-#define VM3   STATE[(state_i + M3) & 0x0000001fU]
-#define VRm1  STATE[(state_i + 31) & 0x0000001fU]
-#define newV0 STATE[(state_i + 31) & 0x0000001fU]
-#define newV1 STATE[state_i]
+#define V0    rs->state[rs->state_i]
+#define VM1   rs->state[(rs->state_i + M1) & 0x0000001fU]
+#define VM2   rs->state[(rs->state_i + M2) & 0x0000001fU]
+#define VM3   rs->state[(rs->state_i + M3) & 0x0000001fU]
+#define VRm1  rs->state[(rs->state_i + 31) & 0x0000001fU]
+#define newV0 rs->state[(rs->state_i + 31) & 0x0000001fU]
+#define newV1 rs->state[rs->state_i]
 
-static uint32_t WELLRNG1024a(void)
+static uint32_t WELLRNG1024a(rand_state *rs)
 {
     uint32_t z0 = VRm1;
     uint32_t z1 = Identity(V0) ^ MAT0POS(8, VM1);
@@ -84,8 +78,8 @@ static uint32_t WELLRNG1024a(void)
 
     newV1   = z1 ^ z2;
     newV0   = MAT0NEG(-11, z0) ^ MAT0NEG(-7, z1) ^ MAT0NEG(-13, z2);
-    state_i = (state_i + 31) & 0x0000001fU;
-    return STATE[state_i];
+    rs->state_i = (rs->state_i + 31) & 0x0000001fU;
+    return rs->state[rs->state_i];
 }
 
 
@@ -96,45 +90,78 @@ static uint32_t WELLRNG1024a(void)
 
 
 /*
- * Whether to use the simple RNG or not
+ * The default stream of each thread (uses the simple RNG until Rand_init() is called)
  */
-bool Rand_quick = true;
+THREAD_LOCAL rand_state Rand_default = {true, 0, 0, {0}};
 
 
 /*
- * The current "seed" of the simple RNG
+ * The current stream of each thread (NULL for the default stream)
  */
-uint32_t Rand_value;
+THREAD_LOCAL rand_state *Rand_current = NULL;
 
 
 /*
- * Initialize the "complex" RNG using a new seed
+ * Make "rs" the current stream of the calling thread, return the previous one
  */
-void Rand_state_init(uint32_t seed)
+rand_state *Rand_state_use(rand_state *rs)
+{
+    rand_state *old = Rand_current;
+
+    Rand_current = rs;
+    return old;
+}
+
+
+/*
+ * Allocate a new stream using the "complex" RNG
+ */
+rand_state *Rand_state_new(uint32_t seed)
+{
+    rand_state *rs = mem_zalloc(sizeof(*rs));
+
+    Rand_state_seed(rs, seed);
+    return rs;
+}
+
+
+/*
+ * Initialize the "complex" RNG of a stream using a new seed
+ */
+void Rand_state_seed(rand_state *rs, uint32_t seed)
 {
     int i, j;
 
     /* Seed the table */
-    STATE[0] = seed;
+    rs->state[0] = seed;
 
     /* Propagate the seed */
-    for (i = 1; i < RAND_DEG; i++) STATE[i] = LCRNG(STATE[i - 1]);
+    for (i = 1; i < RAND_DEG; i++) rs->state[i] = LCRNG(rs->state[i - 1]);
 
     /* Cycle the table ten times per degree */
     for (i = 0; i < RAND_DEG * 10; i++)
     {
         /* Acquire the next index */
-        j = (state_i + 1) % RAND_DEG;
+        j = (rs->state_i + 1) % RAND_DEG;
 
         /* Update the table, extract an entry */
-        STATE[j] += STATE[state_i];
+        rs->state[j] += rs->state[rs->state_i];
 
         /* Advance the index */
-        state_i = j;
+        rs->state_i = j;
     }
 }
 
 
+/*
+ * Initialize the "complex" RNG of the current stream using a new seed
+ */
+void Rand_state_init(uint32_t seed)
+{
+    Rand_state_seed(Rand_state_current(), seed);
+}
+
+
 /*
  * Initialize the RNG
  */
@@ -173,7 +200,7 @@ void Rand_init(void)
  * This method has no bias, and is much less affected by patterns
  * in the "low" bits of the underlying RNG's.
  */
-uint32_t Rand_div(uint32_t m)
+uint32_t Rand_div_r(rand_state *rs, uint32_t m)
 {
     uint32_t n, r = 0;
 
@@ -186,13 +213,13 @@ uint32_t Rand_div(uint32_t m)
     n = (0x10000000 / m);
 
     /* Use a simple RNG */
-    if (Rand_quick)
+    if (rs->quick)
     {
         /* Wait for it */
         while (1)
         {
             /* Cycle the generator */
-            r = (Rand_value = LCRNG(Rand_value));
+            r = (rs->value = LCRNG(rs->value));
 
             /* Mutate a 28-bit "random" number */
             r = ((r >> 4) & 0x0FFFFFFF) / n;
@@ -209,7 +236,7 @@ uint32_t Rand_div(uint32_t m)
         while (1)
         {
             /* Get the next pseudorandom number */
-            r = WELLRNG1024a();
+            r = WELLRNG1024a(rs);
 
             /* Mutate a 28-bit "random" number */
             r = ((r >> 4) & 0x0FFFFFFF) / n;
@@ -224,6 +251,12 @@ uint32_t Rand_div(uint32_t m)
 }
 
 
+uint32_t Rand_div(uint32_t m)
+{
+    return Rand_div_r(Rand_state_current(), m);
+}
+
+
 /*
  * The number of entries in the "Rand_normal_table"
  */
@@ -377,7 +410,7 @@ int Rand_sample(int mean, int upper, int lower, int stand_u, int stand_l)
  */
 uint32_t Rand_simple(uint32_t m)
 {
-    static uint32_t seed;
+    static THREAD_LOCAL uint32_t seed;
     uint32_t v = (uint32_t)time(NULL);
 
 #if defined(_WIN32)
@@ -591,13 +624,86 @@ int random_chance_scaled(random_chance *c, int scale)
 }
 
 
+/*
+ * Build an alias table (Vose's method, with integer weights)
+ *
+ * On entry, cut[] holds the weight of each of the "num" entries and "total" is the sum of
+ * the weights. On exit, entry i must be kept if randint0(total) < cut[i], otherwise alias[i]
+ * must be used instead; see Rand_alias().
+ */
+void Rand_alias_init(uint32_t *cut, int16_t *alias, int num, uint32_t total)
+{
+    uint64_t *scaled;
+    int16_t *small, *large;
+    int num_small = 0, num_large = 0, i;
+
+    if (!num) return;
+
+    scaled = mem_alloc(num * sizeof(uint64_t));
+    small = mem_alloc(num * sizeof(int16_t));
+    large = mem_alloc(num * sizeof(int16_t));
+
+    /* Scale the weights so that the average is "total" */
+    for (i = 0; i < num; i++)
+    {
+        scaled[i] = (uint64_t)cut[i] * num;
+        if (scaled[i] < total) small[num_small++] = (int16_t)i;
+        else large[num_large++] = (int16_t)i;
+    }
+
+    /* Fill each small entry with a large one */
+    while (num_small && num_large)
+    {
+        int16_t less = small[--num_small];
+        int16_t more = large[--num_large];
+
+        cut[less] = (uint32_t)scaled[less];
+        alias[less] = more;
+        scaled[more] -= total - scaled[less];
+        if (scaled[more] < total) small[num_small++] = more;
+        else large[num_large++] = more;
+    }
+
+    /* Remaining entries are full */
+    while (num_large)
+    {
+        i = large[--num_large];
+        cut[i] = total;
+        alias[i] = (int16_t)i;
+    }
+    while (num_small)
+    {
+        i = small[--num_small];
+        cut[i] = total;
+        alias[i] = (int16_t)i;
+    }
+
+    mem_free(large);
+    mem_free(small);
+    mem_free(scaled);
+}
+
+
+/*
+ * Pick an entry of an alias table built by Rand_alias_init() (total must not be 0)
+ */
+int Rand_alias(const uint32_t *cut, const int16_t *alias, int num, uint32_t total)
+{
+    int i = randint0(num);
+
+    if (Rand_div(total) >= cut[i]) i = alias[i];
+
+    return i;
+}
+
+
 /*
  * Extract a "random" number from 0 to m - 1, via "modulus"
  *
  * Note that "m" should probably be less than 500000, or the
  * results may be rather biased towards low values.
  */
-uint32_t Rand_mod(uint32_t m)
+uint32_t Rand_mod_r(rand_state *rs, uint32_t m)
 {
     uint32_t r;
 
@@ -605,10 +711,10 @@ uint32_t Rand_mod(uint32_t m)
     if (m <= 1) return (0);
 
     /* Use the "simple" RNG */
-    if (Rand_quick)
+    if (rs->quick)
     {
         /* Cycle the generator */
-        r = (Rand_value = LCRNG(Rand_value));
+        r = (rs->value = LCRNG(rs->value));
 
         /* Mutate a 28-bit "random" number */
         r = (((r >> 4) & 0x0FFFFFFF) % m);
@@ -618,7 +724,7 @@ uint32_t Rand_mod(uint32_t m)
     else
     {
         /* Get the next pseudorandom number */
-        r = WELLRNG1024a();
+        r = WELLRNG1024a(rs);
 
         /* Mutate a 28-bit "random" number */
         r = (((r >> 4) & 0x0FFFFFFF) % m);
@@ -629,6 +735,12 @@ uint32_t Rand_mod(uint32_t m)
 }
 
 
+uint32_t Rand_mod(uint32_t m)
+{
+    return Rand_mod_r(Rand_state_current(), m);
+}
+
+
 /*
  * Test the integrity of the RNG
  */
@@ -636,35 +748,20 @@ uint32_t Rand_test(uint32_t seed)
 {
     int i;
     uint32_t outcome = 0;
-    bool randquick;
-    uint32_t randvalue, randstate_i, randstate[RAND_DEG];
+    rand_state rs;
 
-    /* Preserve current RNG state */
-    randquick = Rand_quick;
-    randvalue = Rand_value;
-    randstate_i = state_i;
-    for (i = 0; i < RAND_DEG; i++) randstate[i] = STATE[i];
-
-    /* Initialize to a known state */
-    Rand_quick = false;
-    Rand_value = 0;
-    state_i = 0;
-    Rand_state_init(seed);
+    /* Initialize a private stream to a known state */
+    memset(&rs, 0, sizeof(rs));
+    Rand_state_seed(&rs, seed);
 
     /* Torture the RNG for a hundred million iterations */
     for (i = 0; i < 100000000; i++)
     {
         /* Flip between the quick and the complex */
-        Rand_quick = (i % 2);
-        outcome ^= Rand_mod(0x0FFFFFFF);
-        outcome ^= Rand_div(0x0FFFFFFF);
+        rs.quick = (i % 2);
+        outcome ^= Rand_mod_r(&rs, 0x0FFFFFFF);
+        outcome ^= Rand_div_r(&rs, 0x0FFFFFFF);
     }
 
-    /* Restore the RNG state */
-    Rand_quick = randquick;
-    Rand_value = randvalue;
-    state_i = randstate_i;
-    for (i = 0; i < RAND_DEG; i++) STATE[i] = randstate[i];
-
     return outcome;
 }
@@ -89,21 +89,65 @@ typedef enum
  */
 #define CHANCE(A, B) (randint0(B) < (A))
 
+/*
+ * A random number stream.
+ *
+ * Each thread starts with its own default stream; a thread can switch to
+ * another stream (for example one owned by a level) with Rand_state_use().
+ * All the functions below roll on the current stream of the calling thread.
+ */
+typedef struct rand_state
+{
+    bool quick;                 /* Whether we are using the "quick" method or not */
+    uint32_t value;             /* The state used by the "quick" RNG */
+    uint32_t state_i;           /* The state used by the "complex" RNG */
+    uint32_t state[RAND_DEG];
+} rand_state;
+
+/*
+ * The default stream and the current stream (NULL for the default stream) of
+ * each thread. Use Rand_state_current() and Rand_state_use() instead.
+ */
+extern THREAD_LOCAL rand_state Rand_default;
+extern THREAD_LOCAL rand_state *Rand_current;
+
+/*
+ * Get the current stream of the calling thread.
+ *
+ * This is inlined as every roll goes through it.
+ */
+static INLINE rand_state *Rand_state_current(void)
+{
+    if (Rand_current) return Rand_current;
+    return &Rand_default;
+}
+
+/*
+ * Make "rs" the current stream of the calling thread (NULL for the default
+ * stream of the thread). Returns the previous stream.
+ */
+extern rand_state *Rand_state_use(rand_state *rs);
+
+/*
+ * Allocate a new stream using the "complex" RNG, seeded with the given seed.
+ * The stream is freed with mem_free().
+ */
+extern rand_state *Rand_state_new(uint32_t seed);
+
 /*
  * Whether we are currently using the "quick" method or not.
  */
-extern bool Rand_quick;
+#define Rand_quick (Rand_state_current()->quick)
 
 /*
  * The state used by the "quick" RNG.
  */
-extern uint32_t Rand_value;
+#define Rand_value (Rand_state_current()->value)
 
 /*
- * The state used by the "complex" RNG.
+ * Initialize the "complex" RNG state of a stream with the given seed.
  */
-extern uint32_t state_i;
-extern uint32_t STATE[RAND_DEG];
+extern void Rand_state_seed(rand_state *rs, uint32_t seed);
 
 /*
  * Initialize the RNG state with the given seed.
@@ -121,6 +165,7 @@ extern void Rand_init(void);
  * The integer X falls along a uniform distribution.
  */
 extern uint32_t Rand_div(uint32_t m);
+extern uint32_t Rand_div_r(rand_state *rs, uint32_t m);
 
 /*
  * Generate a signed random integer within `stand` standard deviations of
@@ -190,12 +235,19 @@ extern bool randcalc_varies(random_value v);
 extern bool random_chance_check(random_chance *c);
 extern int random_chance_scaled(random_chance *c, int scale);
 
+/*
+ * Alias tables: pick an entry among weighted entries in constant time
+ */
+extern void Rand_alias_init(uint32_t *cut, int16_t *alias, int num, uint32_t total);
+extern int Rand_alias(const uint32_t *cut, const int16_t *alias, int num, uint32_t total);
+
 /*
  * Generates a random unsigned long integer X where "0 <= X < M" holds.
  *
  * The integer X falls along a uniform distribution.
  */
 extern uint32_t Rand_mod(uint32_t m);
+extern uint32_t Rand_mod_r(rand_state *rs, uint32_t m);
 
 /*
  * Test the integrity of the RNG
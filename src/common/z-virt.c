@@ -21,6 +21,33 @@
 #include "angband.h"
 
 
+/* Alignment of the blocks handed out by pools and arenas */
+#define MEM_ALIGN   16
+#define mem_align(len) (((len) + MEM_ALIGN - 1) & ~(size_t)(MEM_ALIGN - 1))
+
+
+/* Heap counters */
+static struct mem_counters heap_counters;
+
+/* Arena counters (all arenas) */
+static struct mem_counters arena_counters;
+
+
+static void counters_alloc(struct mem_counters *counters)
+{
+    counters->allocs++;
+    counters->live++;
+    if (counters->live > counters->peak) counters->peak = counters->live;
+}
+
+
+static void counters_free(struct mem_counters *counters, uint32_t num)
+{
+    counters->frees += num;
+    counters->live -= num;
+}
+
+
 /*
  * Allocate `len` bytes of memory
  *
@@ -37,6 +64,7 @@ void *mem_alloc(size_t len)
     if (!len) return NULL;
     p = malloc(len);
     if (!p) quit("Out of Memory!");
+    counters_alloc(&heap_counters);
 
     return p;
 }
@@ -53,6 +81,7 @@ void* mem_zalloc(size_t len)
 
 void mem_free(void *p)
 {
+    if (p) counters_free(&heap_counters, 1);
     free(p);
 }      
 
@@ -60,6 +89,7 @@ void mem_free(void *p)
 void *mem_realloc(void *p, size_t len)
 {
     if (!len) return NULL;
+    if (!p) counters_alloc(&heap_counters);
     p = realloc(p, len);
     if (!p) quit("Out of Memory!");
     return p;
@@ -149,3 +179,201 @@ void strings_free(const char ***p, uint32_t *plen, size_t len)
     mem_free(p);
     mem_free(plen);
 }
+
+
+/*** Pools ***/
+
+
+/*
+ * A pool hands out blocks of a fixed size, carved from slabs taken from the heap. Freed blocks
+ * are kept on a free list for the next allocation, so the heap is only used when the pool
+ * grows. Slabs are only returned to the heap when the pool is destroyed.
+ */
+struct mem_pool
+{
+    size_t size;                    /* Size of a block */
+    size_t per_slab;                /* Number of blocks in a slab */
+    void *free_list;                /* Free blocks (linked through their first word) */
+    void *slabs;                    /* Slabs (linked through their first word) */
+    struct mem_counters counters;   /* Block counters */
+};
+
+
+/*
+ * Create a pool of blocks of `size` bytes, allocated `per_slab` at a time
+ */
+struct mem_pool *mem_pool_new(size_t size, size_t per_slab)
+{
+    struct mem_pool *pool = mem_zalloc(sizeof(*pool));
+
+    pool->size = mem_align(MAX(size, sizeof(void*)));
+    pool->per_slab = MAX(per_slab, 1);
+
+    return pool;
+}
+
+
+/*
+ * Get a zeroed block from a pool
+ */
+void *mem_pool_zalloc(struct mem_pool *pool)
+{
+    void *p;
+
+    /* Add a slab */
+    if (!pool->free_list)
+    {
+        char *slab = mem_alloc(MEM_ALIGN + pool->size * pool->per_slab);
+        size_t i;
+
+        *(void **)slab = pool->slabs;
+        pool->slabs = slab;
+        pool->counters.slabs++;
+
+        for (i = pool->per_slab; i > 0; i--)
+        {
+            void *block = slab + MEM_ALIGN + pool->size * (i - 1);
+
+            *(void **)block = pool->free_list;
+            pool->free_list = block;
+        }
+    }
+
+    p = pool->free_list;
+    pool->free_list = *(void **)p;
+    memset(p, 0, pool->size);
+    counters_alloc(&pool->counters);
+
+    return p;
+}
+
+
+/*
+ * Give a block back to its pool
+ */
+void mem_pool_free(struct mem_pool *pool, void *p)
+{
+    if (!p) return;
+
+    *(void **)p = pool->free_list;
+    pool->free_list = p;
+    counters_free(&pool->counters, 1);
+}
+
+
+/*
+ * Destroy a pool, returning all its slabs to the heap (blocks still in use become invalid)
+ */
+void mem_pool_destroy(struct mem_pool *pool)
+{
+    if (!pool) return;
+
+    while (pool->slabs)
+    {
+        void *next = *(void **)pool->slabs;
+
+        mem_free(pool->slabs);
+        pool->slabs = next;
+    }
+    mem_free(pool);
+}
+
+
+void mem_pool_counters(const struct mem_pool *pool, struct mem_counters *counters)
+{
+    if (pool) memcpy(counters, &pool->counters, sizeof(*counters));
+    else memset(counters, 0, sizeof(*counters));
+}
+
+
+/*** Arenas ***/
+
+
+/*
+ * An arena hands out blocks of any size from large slabs, and frees them all at once when the
+ * arena itself is freed.
+ */
+struct mem_arena
+{
+    size_t slab_size;   /* Default size of a slab */
+    char *slab;         /* Current slab (slabs are linked through their first word) */
+    size_t used;        /* Bytes used in the current slab */
+    size_t avail;       /* Bytes available in the current slab */
+    uint32_t allocs;    /* Number of blocks handed out */
+};
+
+
+/*
+ * Create an arena, taking memory from the heap `slab_size` bytes at a time
+ */
+struct mem_arena *mem_arena_new(size_t slab_size)
+{
+    struct mem_arena *arena = mem_zalloc(sizeof(*arena));
+
+    arena->slab_size = mem_align(MAX(slab_size, MEM_ALIGN));
+
+    return arena;
+}
+
+
+/*
+ * Get a zeroed block of `len` bytes from an arena
+ */
+void *mem_arena_zalloc(struct mem_arena *arena, size_t len)
+{
+    void *p;
+
+    len = mem_align(MAX(len, 1));
+
+    /* Add a slab (a bigger one if needed) */
+    if (len > arena->avail)
+    {
+        size_t size = MAX(len, arena->slab_size);
+        char *slab = mem_alloc(MEM_ALIGN + size);
+
+        *(void **)slab = arena->slab;
+        arena->slab = slab;
+        arena->used = MEM_ALIGN;
+        arena->avail = size;
+        arena_counters.slabs++;
+    }
+
+    p = arena->slab + arena->used;
+    arena->used += len;
+    arena->avail -= len;
+    memset(p, 0, len);
+    arena->allocs++;
+    counters_alloc(&arena_counters);
+
+    return p;
+}
+
+
+/*
+ * Free an arena and all the blocks it handed out
+ */
+void mem_arena_free(struct mem_arena *arena)
+{
+    if (!arena) return;
+
+    while (arena->slab)
+    {
+        void *next = *(void **)arena->slab;
+
+        mem_free(arena->slab);
+        arena->slab = next;
+        arena_counters.slabs--;
+    }
+    counters_free(&arena_counters, arena->allocs);
+    mem_free(arena);
+}
+
+
+/*
+ * Get the allocation counters of the heap (mem_alloc() and friends) and of all arenas
+ */
+void mem_get_counters(struct mem_counters *heap, struct mem_counters *arenas)
+{
+    memcpy(heap, &heap_counters, sizeof(*heap));
+    memcpy(arenas, &arena_counters, sizeof(*arenas));
+}
@@ -24,4 +24,38 @@ extern void mem_nfree(void **p, size_t len);
 /* Free a bidimentional array of length "len" with its variable lengths "plen" */
 extern void strings_free(const char ***p, uint32_t *plen, size_t len);
 
+/*
+ * Allocation counters
+ */
+struct mem_counters
+{
+    uint32_t allocs;    /* Blocks allocated */
+    uint32_t frees;     /* Blocks freed */
+    uint32_t live;      /* Blocks in use */
+    uint32_t peak;      /* Most blocks in use at once */
+    uint32_t slabs;     /* Slabs taken from the heap (pools and arenas) */
+};
+
+/*
+ * Pools of fixed-size blocks
+ */
+struct mem_pool;
+
+extern struct mem_pool *mem_pool_new(size_t size, size_t per_slab);
+extern void *mem_pool_zalloc(struct mem_pool *pool);
+extern void mem_pool_free(struct mem_pool *pool, void *p);
+extern void mem_pool_destroy(struct mem_pool *pool);
+extern void mem_pool_counters(const struct mem_pool *pool, struct mem_counters *counters);
+
+/*
+ * Arenas: blocks of any size, all freed at once
+ */
+struct mem_arena;
+
+extern struct mem_arena *mem_arena_new(size_t slab_size);
+extern void *mem_arena_zalloc(struct mem_arena *arena, size_t len);
+extern void mem_arena_free(struct mem_arena *arena);
+
+extern void mem_get_counters(struct mem_counters *heap, struct mem_counters *arenas);
+
 #endif
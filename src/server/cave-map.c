@@ -162,6 +162,88 @@ void map_info(struct player *p, struct chunk *c, struct loc *grid, struct grid_d
 }
 
 
+/*
+ * Glyph cache
+ *
+ * The attr/char pairs computed by map_info() and grid_data_as_text() are remembered by each
+ * player for every grid of the level, together with the version stamp of the grid. The stamp is
+ * bumped by square_touch() whenever the grid may look different (feature or monster change,
+ * redraw request), and changes to the knowledge of a player only invalidate their own entry.
+ *
+ * Grids showing monsters, players, hallucinations or multi-hued objects are never cached. A full
+ * map redraw (PR_MAP) starts a new epoch, so the cache is mostly used when the panel scrolls.
+ */
+static uint32_t glyph_stamp;
+
+
+/*
+ * Bump the version stamp of a grid
+ */
+void square_touch(struct chunk *c, struct loc *grid)
+{
+    if (!++glyph_stamp) glyph_stamp = 1;
+    square(c, grid)->stamp = glyph_stamp;
+}
+
+
+/*
+ * Forget the cached glyphs of a grid for a player
+ */
+void glyph_cache_forget(struct player *p, struct loc *grid)
+{
+    if (p->glyph_cache) p->glyph_cache[grid->y][grid->x].epoch = 0;
+}
+
+
+/*
+ * Forget all the cached glyphs of a player
+ */
+void glyph_cache_reset(struct player *p)
+{
+    if (!++p->glyph_epoch) p->glyph_epoch = 1;
+}
+
+
+/*
+ * Get the attr/char pairs of a grid, using the glyph cache if allowed
+ */
+void map_glyph(struct player *p, struct chunk *cv, struct loc *grid, bool cached, uint16_t *a,
+    char *c, uint16_t *ta, char *tc)
+{
+    struct glyph_cache *entry = &p->glyph_cache[grid->y][grid->x];
+    struct grid_data g;
+
+    /* Nothing changed since last time */
+    if (cached && entry->epoch && (entry->epoch == p->glyph_epoch) &&
+        (entry->stamp == square(cv, grid)->stamp))
+    {
+        *a = entry->scr.a;
+        *c = entry->scr.c;
+        *ta = entry->trn.a;
+        *tc = entry->trn.c;
+        prof_count(PROF_GLYPH_HIT, 1);
+        return;
+    }
+
+    /* Examine the grid */
+    map_info(p, cv, grid, &g);
+    grid_data_as_text(p, cv, false, &g, a, c, ta, tc);
+    prof_count(PROF_GLYPH_MISS, 1);
+
+    /* Only cache grids that look the same until something changes */
+    entry->epoch = 0;
+    if (p->timed[TMD_IMAGE] || g.m_idx || g.is_player) return;
+    if (g.first_obj && object_shimmer(g.first_obj)) return;
+
+    entry->stamp = square(cv, grid)->stamp;
+    entry->epoch = p->glyph_epoch;
+    entry->scr.a = *a;
+    entry->scr.c = *c;
+    entry->trn.a = *ta;
+    entry->trn.c = *tc;
+}
+
+
 /*
  * Memorize interesting viewable object/features in the given grid
  *
@@ -249,7 +331,7 @@ void square_note_spot(struct chunk *c, struct loc *grid)
  *
  * This function should only be called on "legal" grids.
  */
-void square_light_spot_aux(struct player *p, struct chunk *cv, struct loc *grid)
+static void square_light_spot_player(struct player *p, struct chunk *cv, struct loc *grid)
 {
     struct loc disp;
 
@@ -261,11 +343,9 @@ void square_light_spot_aux(struct player *p, struct chunk *cv, struct loc *grid)
     {
         uint16_t a, ta;
         char c, tc;
-        struct grid_data g;
 
         /* Examine the grid */
-        map_info(p, cv, grid, &g);
-        grid_data_as_text(p, cv, false, &g, &a, &c, &ta, &tc);
+        map_glyph(p, cv, grid, false, &a, &c, &ta, &tc);
 
         loc_init(&disp, grid->x - p->offset_grid.x, grid->y - p->offset_grid.y + 1);
 
@@ -281,12 +361,21 @@ void square_light_spot_aux(struct player *p, struct chunk *cv, struct loc *grid)
             p->trn_info[disp.y][disp.x].a = ta;
 
             /* Tell client to redraw this grid */
-            Send_char(p, &disp, a, c, ta, tc);
+            Send_char_batched(p, &disp, a, c, ta, tc);
         }
     }
 }
 
 
+void square_light_spot_aux(struct player *p, struct chunk *cv, struct loc *grid)
+{
+    /* The grid may look different to other players too */
+    square_touch(cv, grid);
+
+    square_light_spot_player(p, cv, grid);
+}
+
+
 void square_light_spot(struct chunk *c, struct loc *grid)
 {
     int i;
@@ -294,6 +383,8 @@ void square_light_spot(struct chunk *c, struct loc *grid)
     /* Paranoia */
     if (!c) return;
 
+    square_touch(c, grid);
+
     /* Check everyone */
     for (i = 1; i <= NumPlayers; i++)
     {
@@ -303,7 +394,7 @@ void square_light_spot(struct chunk *c, struct loc *grid)
         if (!wpos_eq(&p->wpos, &c->wpos)) continue;
 
         /* Actually light that spot for that player */
-        square_light_spot_aux(p, c, grid);
+        square_light_spot_player(p, c, grid);
     }
 }
 
@@ -1602,6 +1602,7 @@ void square_excise_object(struct chunk *c, struct loc *grid, struct object *obj)
     pile_excise(&square(c, grid)->obj, obj);
 
     /* Excise object index */
+    floor_timed_remove(c, obj);
     c->o_gen[0 - (obj->oidx + 1)] = false;
     obj->oidx = 0;
 
@@ -1639,6 +1640,7 @@ void square_excise_pile(struct chunk *c, struct loc *grid)
         preserve_artifact(obj);
 
         /* Excise object index */
+        floor_timed_remove(c, obj);
         c->o_gen[0 - (obj->oidx + 1)] = false;
         obj->oidx = 0;
 
@@ -1701,6 +1703,7 @@ void square_sense_pile(struct player *p, struct chunk *c, struct loc *grid)
     /* Sense every item on this grid */
     for (obj = square_object(c, grid); obj; obj = obj->next)
         object_sense(p, obj);
+    glyph_cache_forget(p, grid);
 }
 
 
@@ -1725,7 +1728,7 @@ static bool object_equals(const struct object *obj1, const struct object *obj2)
     /* Known part must be equal */
     if (!object_equals(obj1->known, test->known))
     {
-        mem_free(test);
+        object_free_shallow(test);
         return false;
     }
 
@@ -1735,7 +1738,7 @@ static bool object_equals(const struct object *obj1, const struct object *obj2)
     /* Brands must be equal */
     if (!brands_are_equal(obj1, test))
     {
-        mem_free(test);
+        object_free_shallow(test);
         return false;
     }
 
@@ -1745,7 +1748,7 @@ static bool object_equals(const struct object *obj1, const struct object *obj2)
     /* Slays must be equal */
     if (!slays_are_equal(obj1, test))
     {
-        mem_free(test);
+        object_free_shallow(test);
         return false;
     }
 
@@ -1758,12 +1761,12 @@ static bool object_equals(const struct object *obj1, const struct object *obj2)
     /* All other fields must be equal */
     if (memcmp(obj1, test, sizeof(struct object)) != 0)
     {
-        mem_free(test);
+        object_free_shallow(test);
         return false;
     }
 
     /* Success */
-    mem_free(test);
+    object_free_shallow(test);
     return true;
 }
 
@@ -1783,6 +1786,9 @@ static void square_update_pile(struct player *p, struct chunk *c, struct loc *gr
         /* Attach it to the current floor pile */
         pile_insert_end(&square_p(p, grid)->obj, new_obj);
     }
+    if (square_p(p, grid)->obj) square_list_pile(p, grid);
+
+    glyph_cache_forget(p, grid);
 }
 
 
@@ -1843,6 +1849,26 @@ void square_forget_pile(struct player *p, struct loc *grid)
         current = next;
     }
     square_p(p, grid)->obj = NULL;
+    glyph_cache_forget(p, grid);
+}
+
+
+/*
+ * Remember that a grid holds a known pile, so the object list doesn't have to scan the level
+ */
+void square_list_pile(struct player *p, struct loc *grid)
+{
+    struct player_cave *cave = p->cave;
+
+    if (square_p(p, grid)->listed) return;
+    square_p(p, grid)->listed = true;
+
+    if (cave->num_piles == cave->max_piles)
+    {
+        cave->max_piles = (cave->max_piles? cave->max_piles * 2: 64);
+        cave->piles = mem_realloc(cave->piles, cave->max_piles * sizeof(struct loc));
+    }
+    loc_copy(&cave->piles[cave->num_piles++], grid);
 }
 
 
@@ -1902,6 +1928,8 @@ void square_set_feat(struct chunk *c, struct loc *grid, int feat)
 
     /* Make the change */
     square(c, grid)->feat = feat;
+    square_touch(c, grid);
+    c->feat_changes++;
 
     /* Light bright terrain */
     if (feat_is_bright(feat)) sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
@@ -1932,6 +1960,7 @@ void square_set_feat(struct chunk *c, struct loc *grid, int feat)
  */
 static void square_set_known_feat(struct player *p, struct loc *grid, int feat)
 {
+    if (square_p(p, grid)->feat != feat) glyph_cache_forget(p, grid);
     square_p(p, grid)->feat = feat;
 }
 
@@ -1942,6 +1971,7 @@ static void square_set_known_feat(struct player *p, struct loc *grid, int feat)
 void square_set_mon(struct chunk *c, struct loc *grid, int midx)
 {
     square(c, grid)->mon = midx;
+    square_touch(c, grid);
 }
 
 
@@ -2794,6 +2824,7 @@ void square_memorize_trap(struct player *p, struct chunk *c, struct loc *grid)
         square_p(p, grid)->trap->kind = trap->kind;
         loc_copy(&square_p(p, grid)->trap->grid, &trap->grid);
         trf_copy(square_p(p, grid)->trap->flags, trap->flags);
+        glyph_cache_forget(p, grid);
     }
 }
 
@@ -2813,6 +2844,7 @@ void square_forget_trap(struct player *p, struct loc *grid)
     {
         mem_free(square_p(p, grid)->trap);
         square_p(p, grid)->trap = NULL;
+        glyph_cache_forget(p, grid);
     }
 }
 
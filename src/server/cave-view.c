@@ -1016,6 +1016,7 @@ void update_view(struct player *p, struct chunk *c)
 {
     struct loc begin, end;
     struct loc_iterator iter;
+    uint64_t start = prof_clock();
 
     /* Record the current view */
     mark_wasseen(p, c);
@@ -1061,6 +1062,8 @@ void update_view(struct player *p, struct chunk *c)
         update_one(p, c, &iter.cur);
     }
     while (loc_iterator_next_strict(&iter));
+
+    prof_account(PROF_VIEW, start);
 }
 
 
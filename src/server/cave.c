@@ -303,15 +303,17 @@ struct chunk *cave_new(int height, int width)
     c->feat_count = mem_zalloc(FEAT_MAX * sizeof(int));
 
     c->squares = mem_zalloc(c->height * sizeof(struct square*));
+    c->arena = mem_arena_new(c->height * c->width * SQUARE_SIZE * sizeof(bitflag));
     for (grid.y = 0; grid.y < c->height; grid.y++)
     {
         c->squares[grid.y] = mem_zalloc(c->width * sizeof(struct square));
         for (grid.x = 0; grid.x < c->width; grid.x++)
-            square(c, &grid)->info = mem_zalloc(SQUARE_SIZE * sizeof(bitflag));
+            square(c, &grid)->info = mem_arena_zalloc(c->arena, SQUARE_SIZE * sizeof(bitflag));
     }
 
     c->monsters = mem_zalloc(z_info->level_monster_max * sizeof(struct monster));
     c->mon_max = 1;
+    c->mon_ready = mem_zalloc(z_info->level_monster_max * sizeof(int16_t));
 
     c->monster_groups = mem_zalloc(z_info->level_monster_max * sizeof(struct monster_group*));
 
@@ -333,7 +335,6 @@ void cave_free(struct chunk *c)
     {
         for (grid.x = 0; grid.x < c->width; grid.x++)
         {
-            mem_free(square(c, &grid)->info);
             if (square(c, &grid)->trap)
                 square_free_trap(c, &grid);
             if (square(c, &grid)->obj)
@@ -342,16 +343,40 @@ void cave_free(struct chunk *c)
         mem_free(c->squares[grid.y]);
     }
     mem_free(c->squares);
+    mem_arena_free(c->arena);
 
     mem_free(c->feat_count);
     mem_free(c->monsters);
+    mem_free(c->mon_ready);
+    mem_free(c->path_cache);
     mem_free(c->monster_groups);
     mem_free(c->o_gen);
+    mem_free(c->timed_obj);
+    mem_free(c->timed_pos);
     mem_free(c->join);
+    mem_free(c->rng);
     mem_free(c);
 }
 
 
+/*
+ * Get the private random stream of a chunk, creating it on first use
+ *
+ * Like the wilderness terrain, the stream is seeded from the location of the level (plus the
+ * turn it was generated, so a new level gets a new stream): the shared stream isn't touched.
+ */
+rand_state *cave_rng(struct chunk *c)
+{
+    if (!c->rng)
+    {
+        c->rng = Rand_state_new(seed_wild + world_index(&c->wpos) * 600 + c->wpos.depth * 37 +
+            c->generated.era * HTURN_ERA_FLIP + c->generated.turn);
+    }
+
+    return c->rng;
+}
+
+
 /*
  * Standard "find me a location" function, now with all legal outputs!
  *
@@ -645,14 +670,12 @@ void display_fullmap(struct player *p)
         {
             uint16_t a, ta;
             char c, tc;
-            struct grid_data g;
 
             /* Check bounds */
             if (!square_in_bounds(cv, &grid)) continue;
 
             /* Determine what is there */
-            map_info(p, cv, &grid, &g);
-            grid_data_as_text(p, cv, false, &g, &a, &c, &ta, &tc);
+            map_glyph(p, cv, &grid, true, &a, &c, &ta, &tc);
 
             p->scr_info[grid.y][grid.x].c = c;
             p->scr_info[grid.y][grid.x].a = a;
@@ -74,6 +74,7 @@ struct square
     uint16_t feat;
     bitflag *info;
     int16_t mon;
+    uint32_t stamp;
     struct object *obj;
     struct trap *trap;
 };
@@ -96,12 +97,18 @@ struct chunk
     int *feat_count;
 
     struct square **squares;
+    struct mem_arena *arena;    /* Square info flags, freed with the chunk */
     struct loc decoy;
 
     struct monster *monsters;
     uint16_t mon_max;
     uint16_t mon_cnt;
     int num_repro;
+    int16_t *mon_ready;         /* Monsters with enough energy to act, by decreasing index */
+    int mon_ready_num;
+    uint32_t player_steps;      /* Grids moved by the players on the level (see park_monster()) */
+    uint32_t feat_changes;      /* Number of terrain changes on the level */
+    struct path_cache_entry *path_cache;    /* Recent projection paths (see project_path()) */
 
     struct monster_group **monster_groups;
 
@@ -111,11 +118,17 @@ struct chunk
     bool scan_monsters;
     hturn generated;
     bool *o_gen;
+    struct object **timed_obj;  /* Floor objects that need processing (rods, corpses) */
+    uint16_t *timed_pos;        /* Position in timed_obj (+1), by floor object index */
+    int timed_num;
+    int timed_alloc;
 
     bool light_level;
     bool gen_hack;
 
     int profile;
+
+    rand_state *rng;            /* Private random stream (see cave_rng()) */
 };
 
 /*
@@ -153,6 +166,7 @@ extern void next_grid(struct loc *next, struct loc *grid, int dir);
 extern int lookup_feat_code(const char *code);
 extern struct chunk *cave_new(int height, int width);
 extern void cave_free(struct chunk *c);
+extern rand_state *cave_rng(struct chunk *c);
 extern bool scatter(struct chunk *c, struct loc *place, struct loc *grid, int d, bool need_los);
 extern int scatter_ext(struct chunk *c, struct loc *places, int n, struct loc *grid, int d,
     bool need_los, bool (*pred)(struct chunk *, struct loc *));
@@ -179,6 +193,11 @@ extern void add_moat(struct chunk *c, struct loc *grid1, struct loc *grid2, stru
 
 /* cave-map.c */
 extern void map_info(struct player *p, struct chunk *c, struct loc *grid, struct grid_data *g);
+extern void square_touch(struct chunk *c, struct loc *grid);
+extern void glyph_cache_forget(struct player *p, struct loc *grid);
+extern void glyph_cache_reset(struct player *p);
+extern void map_glyph(struct player *p, struct chunk *cv, struct loc *grid, bool cached, uint16_t *a,
+    char *c, uint16_t *ta, char *tc);
 extern void square_note_spot_aux(struct player *p, struct chunk *c, struct loc *grid);
 extern void square_note_spot(struct chunk *c, struct loc *grid);
 extern void square_light_spot_aux(struct player *p, struct chunk *cv, struct loc *grid);
@@ -358,6 +377,7 @@ extern void square_delete_object(struct chunk *c, struct loc *grid, struct objec
 extern void square_sense_pile(struct player *p, struct chunk *c, struct loc *grid);
 extern void square_know_pile(struct player *p, struct chunk *c, struct loc *grid);
 extern void square_forget_pile(struct player *p, struct loc *grid);
+extern void square_list_pile(struct player *p, struct loc *grid);
 extern struct object *square_known_pile(struct player *p, struct chunk *c, struct loc *grid);
 extern int square_num_walls_adjacent(struct chunk *c, struct loc *grid);
 extern void square_set_feat(struct chunk *c, struct loc *grid, int feat);
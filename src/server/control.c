@@ -45,6 +45,7 @@ static void console_whois(int ind, char *name);
 static void console_message(int ind, char *buf);
 static void console_kick_player(int ind, char *name);
 static void console_rng_test(int ind, char *dummy);
+static void console_prof(int ind, char *arg);
 static void console_reload(int ind, char *mod);
 static void console_shutdown(int ind, char *dummy);
 static void console_wrath(int ind, char *name);
@@ -63,6 +64,7 @@ static console_command_ops console_commands[] =
     {"reload", console_reload, 1, "config|news\nReload mangband.cfg or news.txt"},
     {"whois", console_whois, 1, "PLAYERNAME\nDetailed player information"},
     {"rngtest", console_rng_test, 0, "\nPerform RNG test"},
+    {"prof", console_prof, 0, "[reset]\nDisplay or reset the frame profiler and performance counters"},
     {"debug", console_debug, 0, "\nUnused"}
 };
 
@@ -519,6 +521,92 @@ static void console_rng_test(int ind, char *dummy)
 }
 
 
+/*
+ * Display the frame profiler and the performance counters
+ *
+ * Counters are totals since startup or the last "prof reset". Times are per frame: p50/p99 are
+ * upper bounds of log2 histogram buckets and only count the frames where the phase ran.
+ */
+static void console_prof(int ind, char *arg)
+{
+    sockbuf_t *console_buf_w = (sockbuf_t*)console_buffer(ind, CONSOLE_WRITE);
+    struct prof_stats frame, stats;
+    uint64_t usecs;
+    uint32_t calls, overruns, late, caught_up, dropped, shed, hits, misses;
+    struct mem_counters heap, arena, objs, curse_arrays;
+    int i;
+
+    if (arg && streq(arg, "reset"))
+    {
+        prof_reset();
+        Packet_printf(console_buf_w, "%s", "Frame profiler and counters reset\n");
+        Sockbuf_flush(console_buf_w);
+        return;
+    }
+
+    prof_window(PROF_MAX, &frame);
+    prof_totals(PROF_MAX, &usecs, &calls, &overruns);
+    Packet_printf(console_buf_w, "%S",
+        format("%u frames in the last %d s, %u over the %d us budget (%u of %u since startup)\n",
+        frame.frames, prof_window_secs(), frame.overruns, 1000000 / cfg_fps, overruns, calls));
+    prof_sched_totals(&late, &caught_up, &dropped, &shed);
+    Packet_printf(console_buf_w, "%S",
+        format("Late %u times: %u frames caught up (max %d per tick), %u dropped\n", late,
+        caught_up, cfg_catch_up_frames, dropped));
+    Packet_printf(console_buf_w, "%S",
+        format("Overloaded: monster/object lists deferred in %u frames\n", shed));
+    Packet_printf(console_buf_w, "%S",
+        format("Dice cache: %u entries, %u hits, %u misses (%.1f parses avoided/s)\n",
+        effect_simple_cache_entries(), prof_counter(PROF_DICE_HIT), prof_counter(PROF_DICE_MISS),
+        prof_counter_rate(PROF_DICE_HIT)));
+    Packet_printf(console_buf_w, "%S",
+        format("Map lines: %u full, %u delta, %u unchanged\n", prof_counter(PROF_MAP_FULL),
+        prof_counter(PROF_MAP_DELTA), prof_counter(PROF_MAP_SKIPPED)));
+    Packet_printf(console_buf_w, "%S",
+        format("Map grids: %u batched in %u packets\n", prof_counter(PROF_MAP_GRIDS),
+        prof_counter(PROF_MAP_PACKETS)));
+    Packet_printf(console_buf_w, "%S",
+        format("Glyph cache: %u hits, %u misses\n", prof_counter(PROF_GLYPH_HIT),
+        prof_counter(PROF_GLYPH_MISS)));
+    hits = prof_counter(PROF_PATH_HIT);
+    misses = prof_counter(PROF_PATH_MISS);
+    Packet_printf(console_buf_w, "%S",
+        format("Projection paths: %u cache hits, %u misses (%u%% hit rate)\n", hits, misses,
+        ((hits + misses)? (uint32_t)((uint64_t)hits * 100 / (hits + misses)): 0)));
+    mem_get_counters(&heap, &arena);
+    object_pool_counters(&objs, &curse_arrays);
+    Packet_printf(console_buf_w, "%S",
+        format("Heap: %u allocations, %u live (peak %u)\n", heap.allocs, heap.live, heap.peak));
+    Packet_printf(console_buf_w, "%S",
+        format("Pools: %u objects (%u live in %u slabs), %u curses (%u live in %u slabs)\n",
+        objs.allocs, objs.live, objs.slabs, curse_arrays.allocs, curse_arrays.live,
+        curse_arrays.slabs));
+    Packet_printf(console_buf_w, "%S",
+        format("Arenas: %u square flags (%u live in %u slabs)\n", arena.allocs, arena.live,
+        arena.slabs));
+    if (!frame.frames)
+    {
+        Sockbuf_flush(console_buf_w);
+        return;
+    }
+
+    Packet_printf(console_buf_w, "%S",
+        format("%-16s %8s %8s %8s %8s %8s %6s\n", "phase", "calls/f", "mean", "p50", "p99",
+        "max", "%time"));
+    for (i = 0; i <= PROF_MAX; i++)
+    {
+        prof_window(i, &stats);
+        Packet_printf(console_buf_w, "%S",
+            format("%-16s %8.2f %8lu %8lu %8lu %8lu %5.1f%%\n", prof_name(i),
+            (double)stats.calls / frame.frames, (unsigned long)(stats.usecs / frame.frames),
+            (unsigned long)stats.p50, (unsigned long)stats.p99, (unsigned long)stats.max,
+            (frame.usecs? 100.0 * stats.usecs / frame.usecs: 0.0)));
+    }
+
+    Sockbuf_flush(console_buf_w);
+}
+
+
 static void console_reload(int ind, char *mod)
 {
     sockbuf_t *console_buf_w = (sockbuf_t*)console_buffer(ind, CONSOLE_WRITE);
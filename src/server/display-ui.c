@@ -674,7 +674,7 @@ static void fix_monster(struct player *p)
 static void fix_monlist(struct player *p)
 {
     /* Display visible monsters */
-    monster_list_show_subwindow(p, p->max_hgt - 2, p->monwidth);
+    if (!monster_list_show_subwindow(p, p->max_hgt - 2, p->monwidth)) return;
 
     /* Notify player */
     notify_player_popup(p, "Monster List", NTERM_WIN_MONLIST, 0);
@@ -731,7 +731,7 @@ static void fix_object(struct player *p)
 static void fix_objlist(struct player *p)
 {
     /* Display visible objects */
-    object_list_show_subwindow(p, p->max_hgt - 2, NORMAL_WID - 5);
+    if (!object_list_show_subwindow(p, p->max_hgt - 2, NORMAL_WID - 5)) return;
 
     /* Notify player */
     notify_player_popup(p, "Object List", NTERM_WIN_OBJLIST, 0);
@@ -1620,7 +1620,11 @@ static void prt_stats(struct player *p)
 
 static void prt_minimap(struct player *p)
 {
-    prt_map(p);
+    /* Anything may have changed */
+    glyph_cache_reset(p);
+    p->upkeep->redraw_panel = false;
+
+    prt_map(p, false);
     if (p->window_flag & PW_MAP) fix_map(p);
 }
 
@@ -1738,11 +1742,19 @@ void redraw_stuff(struct player *p)
     size_t i;
 
     /* Nothing to do */
-    if (!p->upkeep->redraw) return;
+    if (!p->upkeep->redraw && !p->upkeep->redraw_panel) return;
 
     /* Character is not ready yet, no screen updates */
     if (!p->alive) return;
 
+    /* Panel change: only grids that changed need to be computed again */
+    if (p->upkeep->redraw_panel && !(p->upkeep->redraw & PR_MAP))
+    {
+        p->upkeep->redraw_panel = false;
+        prt_map(p, true);
+        if (p->window_flag & PW_MAP) fix_map(p);
+    }
+
     /* While running, only update monster/object lists when panel changes */
     if (p->upkeep->running)
         p->full_refresh = p->upkeep->running_update;
@@ -2335,7 +2347,7 @@ bool modify_panel(struct player *p, struct loc *grid)
         p->upkeep->update |= (PU_MONSTERS);
 
         /* Redraw map */
-        p->upkeep->redraw |= (PR_MAP);
+        p->upkeep->redraw_panel = true;
 
         /* While running, only update object/monster lists when panel changes */
         if (p->upkeep->running) p->upkeep->running_update = true;
@@ -5348,15 +5360,15 @@ void bolt_pict(struct player *p, struct loc *start, struct loc *end, int typ, ui
 void display_explosion(struct chunk *cv, struct explosion *data, const bool *drawing, bool arc)
 {
     bool new_radius = false;
-    bool drawn[MAX_PLAYERS];
+    bool drawn[MAX_PLAYERS + 1];
     int i, j;
     int proj_type = data->proj_type;
     int num_grids = data->num_grids;
     const int *distance_to_grid = data->distance_to_grid;
     struct loc *blast_grid = (struct loc *)data->blast_grid;
 
-    /* Assume the player has seen no blast grids */
-    for (i = 0; i < MAX_PLAYERS; ++i) drawn[i] = false;
+    /* Assume the player has seen no blast grids (only connected players are checked) */
+    memset(drawn, 0, (NumPlayers + 1) * sizeof(bool));
 
     /* Draw the blast from inside out */
     for (i = 0; i < num_grids; i++)
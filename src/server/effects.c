@@ -566,6 +566,96 @@ bool effect_do(struct effect *effect, struct source *origin, bool *ident, bool a
 }
 
 
+/*
+ * Cache of parsed dice strings used by effect_simple()
+ *
+ * Most callers pass literal strings ("0", "1", "250+1d250"...), so parsing them again on
+ * every call is wasted work. Entries are immutable once added and live until cleanup.
+ * Dynamically built strings could grow the cache without bounds, so we stop adding new
+ * entries past DICE_CACHE_MAX and parse those on the fly instead.
+ */
+#define DICE_CACHE_SIZE 128
+#define DICE_CACHE_MAX  512
+
+
+struct dice_cache_entry
+{
+    char *string;
+    dice_t *dice;
+    struct dice_cache_entry *next;
+};
+
+
+static struct dice_cache_entry *dice_cache[DICE_CACHE_SIZE];
+static uint32_t dice_cache_count;
+
+
+/*
+ * Get the parsed dice for a dice string, parsing and caching it if needed
+ *
+ * Returns NULL if the cache is full; the caller must then parse the string itself.
+ */
+static dice_t *dice_cache_get(const char *string)
+{
+    uint32_t h = djb2_hash(string) % DICE_CACHE_SIZE;
+    struct dice_cache_entry *entry;
+
+    for (entry = dice_cache[h]; entry; entry = entry->next)
+    {
+        if (streq(entry->string, string))
+        {
+            prof_count(PROF_DICE_HIT, 1);
+            return entry->dice;
+        }
+    }
+
+    prof_count(PROF_DICE_MISS, 1);
+    if (dice_cache_count >= DICE_CACHE_MAX) return NULL;
+
+    entry = mem_zalloc(sizeof(*entry));
+    entry->string = string_make(string);
+    entry->dice = dice_new();
+    dice_parse_string(entry->dice, string);
+    entry->next = dice_cache[h];
+    dice_cache[h] = entry;
+    dice_cache_count++;
+
+    return entry->dice;
+}
+
+
+static void dice_cache_free(void)
+{
+    int i;
+
+    for (i = 0; i < DICE_CACHE_SIZE; i++)
+    {
+        struct dice_cache_entry *entry = dice_cache[i];
+
+        while (entry)
+        {
+            struct dice_cache_entry *next = entry->next;
+
+            string_free(entry->string);
+            dice_free(entry->dice);
+            mem_free(entry);
+            entry = next;
+        }
+        dice_cache[i] = NULL;
+    }
+    dice_cache_count = 0;
+}
+
+
+/*
+ * Get the number of dice strings in the effect_simple() dice cache
+ */
+uint32_t effect_simple_cache_entries(void)
+{
+    return dice_cache_count;
+}
+
+
 /*
  * Perform a single effect with a simple dice string and parameters
  * Calling with ident a valid pointer will (depending on effect) give success
@@ -577,12 +667,18 @@ bool effect_simple(int index, struct source *origin, const char *dice_string, in
     struct effect effect;
     int dir = 0;
     bool dummy_ident = false, result;
+    dice_t *dice = NULL;
 
     /* Set all the values */
     memset(&effect, 0, sizeof(effect));
     effect.index = index;
-    effect.dice = dice_new();
-    dice_parse_string(effect.dice, dice_string);
+    effect.dice = dice_cache_get(dice_string);
+    if (!effect.dice)
+    {
+        dice = dice_new();
+        dice_parse_string(dice, dice_string);
+        effect.dice = dice;
+    }
     effect.subtype = subtype;
     effect.radius = radius;
     effect.other = other;
@@ -598,6 +694,14 @@ bool effect_simple(int index, struct source *origin, const char *dice_string, in
     else
         result = effect_do(&effect, origin, &dummy_ident, true, dir, NULL, 0, 0, NULL);
 
-    dice_free(effect.dice);
+    dice_free(dice);
     return result;
 }
+
+
+struct init_module effects_module =
+{
+    "effects",
+    NULL,
+    dice_cache_free
+};
@@ -27,5 +27,6 @@ extern bool effect_do(struct effect *effect, struct source *origin, bool *ident,
     int dir, struct beam_info *beam, int boost, quark_t note, struct monster *target_mon);
 extern bool effect_simple(int index, struct source *origin, const char *dice_string, int subtype,
     int radius, int other, int y, int x, bool *ident);
+extern uint32_t effect_simple_cache_entries(void);
 
 #endif /* INCLUDED_EFFECTS_H */
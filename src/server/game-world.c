@@ -1237,6 +1237,7 @@ static void process_various(void)
     if (!(turn.turn % (cfg_fps * 60 * SERVER_SAVE)))
     {
         int i;
+        uint64_t start = prof_clock();
 
         /* Save server state + player names */
         save_server_info(false);
@@ -1250,6 +1251,8 @@ static void process_various(void)
             /* Save this player */
             if (!p->upkeep->funeral) save_player(p, false);
         }
+
+        prof_account(PROF_SAVE, start);
     }
 
     /* Handle certain things once a minute */
@@ -1791,6 +1794,7 @@ static void generate_new_level(struct player *p)
 
     /* Add the player */
     square_set_mon(c, &p->grid, 0 - id);
+    wake_dormant_monsters(c, -1);
 
     /* Redraw */
     square_light_spot(c, &p->grid);
@@ -1897,6 +1901,9 @@ static void energize_monsters(struct chunk *c)
     int i;
     int mspeed, energy;
 
+    /* Rebuild the list of monsters that can act */
+    c->mon_ready_num = 0;
+
     /* Process the monsters (backwards) */
     for (i = cave_monster_max(c) - 1; i >= 1; i--)
     {
@@ -1906,8 +1913,8 @@ static void energize_monsters(struct chunk *c)
         mon = cave_monster(c, i);
         if (!mon->race) continue;
 
-        /* Skip "unconscious" monsters */
-        if (mon->hp == 0) continue;
+        /* Skip "unconscious" and dormant monsters */
+        if ((mon->hp == 0) || mflag_has(mon->mflag, MFLAG_DORMANT)) continue;
 
         /* Calculate the net speed */
         mspeed = mon->mspeed;
@@ -1941,6 +1948,10 @@ static void energize_monsters(struct chunk *c)
             /* Give this monster some energy */
             mon->energy += energy;
         }
+
+        /* Monster will be able to act next turn */
+        if (mon->energy >= move_energy(mon->wpos.depth))
+            c->mon_ready[c->mon_ready_num++] = (int16_t)i;
     }
 }
 
@@ -1952,11 +1963,14 @@ static void pre_turn_game_loop(void)
 {
     int i;
     struct loc grid;
+    uint64_t start;
 
     on_new_level();
 
     /* Handle any network stuff */
+    start = prof_clock();
     Net_input();
+    prof_account(PROF_NET_INPUT, start);
 
     /* Process monsters with even more energy first */
     for (grid.y = radius_wild; grid.y >= 0 - radius_wild; grid.y--)
@@ -1969,7 +1983,12 @@ static void pre_turn_game_loop(void)
             {
                 struct chunk *c = w_ptr->chunk_list[i];
 
-                if (c) process_monsters(c, true);
+                if (c)
+                {
+                    start = prof_clock();
+                    process_monsters(c, true);
+                    prof_account(PROF_MONSTERS_PRE, start);
+                }
             }
         }
     }
@@ -2012,6 +2031,8 @@ static void post_turn_game_loop(void)
 {
     int i;
     struct loc grid;
+    uint64_t start;
+    static int shed_frames = 0;
 
     /* Check for death */
     process_death();
@@ -2029,7 +2050,9 @@ static void post_turn_game_loop(void)
 
                 if (c)
                 {
+                    start = prof_clock();
                     process_monsters(c, false);
+                    prof_account(PROF_MONSTERS_POST, start);
 
                     /* Mark all monsters as ready to act when they have the energy */
                     reset_monsters(c);
@@ -2069,7 +2092,12 @@ static void post_turn_game_loop(void)
                 struct chunk *c = w_ptr->chunk_list[i];
 
                 /* Process the world every ten turns */
-                if (c && !(turn.turn % 10)) process_world(NULL, c);
+                if (c && !(turn.turn % 10))
+                {
+                    start = prof_clock();
+                    process_world(NULL, c);
+                    prof_account(PROF_WORLD, start);
+                }
             }
         }
     }
@@ -2081,7 +2109,11 @@ static void post_turn_game_loop(void)
 
         /* Process the world of that player */
         if (!p->upkeep->new_level_method && !p->upkeep->funeral)
+        {
+            start = prof_clock();
             process_world(p, chunk_get(&p->wpos));
+            prof_account(PROF_WORLD, start);
+        }
     }
 
     /* Process everything else */
@@ -2155,6 +2187,15 @@ static void post_turn_game_loop(void)
         }
     }
 
+    /* Overloaded: defer monster/object list updates, but not for more than half a second */
+    if (cfg_shed_load && prof_overloaded() && (shed_frames < cfg_fps / 2))
+    {
+        shed_frames++;
+        prof_shed();
+    }
+    else
+        shed_frames = 0;
+
     /* Refresh everybody's displays */
     for (i = 1; i <= NumPlayers; i++)
     {
@@ -2163,10 +2204,12 @@ static void post_turn_game_loop(void)
         if (p->upkeep->funeral) continue;
 
         /* Full refresh (includes monster/object lists) */
-        p->full_refresh = true;
+        p->full_refresh = !shed_frames;
 
         /* Refresh */
+        start = prof_clock();
         refresh_stuff(p);
+        prof_account(PROF_REFRESH, start);
 
         /* Normal refresh (without monster/object lists) */
         p->full_refresh = false;
@@ -2196,7 +2239,9 @@ static void post_turn_game_loop(void)
     }
 
     /* Send any information over the network */
+    start = prof_clock();
     Net_output();
+    prof_account(PROF_NET_OUTPUT, start);
 
     /* Get rid of dead players */
     for (i = NumPlayers; i > 0; i--)
@@ -2245,7 +2290,12 @@ static void post_turn_game_loop(void)
     {
         struct player *p = player_get(i);
 
-        if (p->upkeep->new_level_method) generate_new_level(p);
+        if (p->upkeep->new_level_method)
+        {
+            start = prof_clock();
+            generate_new_level(p);
+            prof_account(PROF_GENERATE, start);
+        }
     }
 }
 
@@ -2338,6 +2388,13 @@ static void process_player_turn_based(struct player *p)
 void run_game_loop(void)
 {
     int i;
+    uint64_t start;
+
+    /* Run the soak benchmark bots */
+    if (soak_bots) soak_begin_frame();
+
+    /* Time the frame */
+    prof_begin_frame();
 
     /* HIGHLY EXPERIMENTAL: turn-based mode (for single player games) */
     if (TURN_BASED && process_turn_based())
@@ -2372,6 +2429,7 @@ void run_game_loop(void)
             Net_output_p(p);
         }
 
+        prof_end_frame();
         return;
     }
 
@@ -2379,6 +2437,7 @@ void run_game_loop(void)
     pre_turn_game_loop();
 
     /* Process the players */
+    start = prof_clock();
     for (i = 1; i <= NumPlayers; i++)
     {
         struct player *p = player_get(i);
@@ -2386,9 +2445,15 @@ void run_game_loop(void)
         /* Process that player */
         if (!p->upkeep->new_level_method && !p->upkeep->funeral) process_player(p);
     }
+    prof_account(PROF_PLAYERS, start);
 
     /* Execute post-turn processing */
     post_turn_game_loop();
+
+    prof_end_frame();
+
+    /* Soak benchmark: record the frame time */
+    if (soak_bots) soak_end_frame();
 }
 
 
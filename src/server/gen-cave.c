@@ -4814,7 +4814,7 @@ struct chunk *lair_gen(struct player *p, struct worldpos *wpos, int min_height,
         for (x = x_size / 2; x < x_size; x++)
         {
             memset(&c->squares[y][x], 0, sizeof(struct square));
-            c->squares[y][x].info = mem_zalloc(SQUARE_SIZE * sizeof(bitflag));
+            c->squares[y][x].info = mem_arena_zalloc(c->arena, SQUARE_SIZE * sizeof(bitflag));
         }
     }
     player_cave_new(p, y_size, x_size);
@@ -146,6 +146,17 @@ void shuffle(int *arr, int n)
 }
 
 
+/*
+ * Number of grids picked at random (with replacement) before a search falls back to going
+ * through a random permutation of the whole rectangle.
+ *
+ * Most searches look for grids that are common (empty floor grids...), so a few random picks
+ * are usually enough; building the permutation costs as much as the rectangle is large. The
+ * permutation is only needed to find rare grids and to tell that there are none left.
+ */
+#define CAVE_FIND_PROBES 64
+
+
 /*
  * Set up to locate a square in a rectangular region of a chunk.
  *
@@ -160,11 +171,12 @@ int *cave_find_init(struct loc *top_left, struct loc *bottom_right)
     struct loc diff;
     int n;
     int *state;
-    int i;
 
     loc_diff(&diff, bottom_right, top_left);
     n = ((diff.y < 0 || diff.x < 0)? 0: (diff.x + 1) * (diff.y + 1));
-    state = mem_alloc((5 + n) * sizeof(*state));
+
+    /* The permutation is only filled if needed, see cave_find_get_grid() */
+    state = mem_alloc((7 + n) * sizeof(*state));
 
     state[0] = n;
     state[1] = diff.x + 1;
@@ -174,8 +186,11 @@ int *cave_find_init(struct loc *top_left, struct loc *bottom_right)
     /* The next to search is the first one. */
     state[4] = 0;
 
-    /* Set up for left to right, top to bottom, search; will randomize in cave_find_get_grid(). */
-    for (i = 5; i < 5 + n; ++i) state[i] = i - 5;
+    /* Random picks left */
+    state[5] = MIN(n, CAVE_FIND_PROBES);
+
+    /* The permutation is not filled yet */
+    state[6] = 0;
 
     return state;
 }
@@ -190,12 +205,18 @@ void cave_find_reset(int *state)
 {
     /* The next to search is the first one. */
     state[4] = 0;
+    state[5] = MIN(state[0], CAVE_FIND_PROBES);
 }
 
 
 /*
  * Get the next grid for a search created by cave_find_init().
  *
+ * The first grids are picked at random, and may be returned more than once. After that, the
+ * remaining grids are taken from a random permutation of the rectangle, so every grid is
+ * eventually returned. Either way, the first grid that satisfies a predicate is picked
+ * uniformly among the grids that satisfy it.
+ *
  * grid is dereferenced and set to the grid to check.
  * state is the search state created by cave_find_init().
  *
@@ -210,17 +231,34 @@ bool cave_find_get_grid(struct loc *grid, int *state)
     my_assert(state[4] >= 0);
     if (state[4] >= state[0]) return false;
 
-    /* Choose one of the remaining ones at random. Swap it with the one that's next in order. */
-    j = randint0(state[0] - state[4]) + state[4];
-    k = state[5 + j];
-    state[5 + j] = state[5 + state[4]];
-    state[5 + state[4]] = k;
+    /* Pick a grid at random */
+    if (state[5] > 0)
+    {
+        state[5]--;
+        k = randint0(state[0]);
+    }
+    else
+    {
+        /* Set up for left to right, top to bottom, search */
+        if (!state[6])
+        {
+            for (j = 0; j < state[0]; j++) state[7 + j] = j;
+            state[6] = 1;
+        }
+
+        /* Choose one of the remaining ones at random. Swap it with the one that's next in order. */
+        j = randint0(state[0] - state[4]) + state[4];
+        k = state[7 + j];
+        state[7 + j] = state[7 + state[4]];
+        state[7 + state[4]] = k;
+
+        /* Increment so a future call to cave_find_get_grid() will get the next one. */
+        ++state[4];
+    }
 
     grid->y = (k / state[1]) + state[3];
     grid->x = (k % state[1]) + state[2];
 
-    /* Increment so a future call to cave_find_get_grid() will get the next one. */
-    ++state[4];
     return true;
 }
 
@@ -83,6 +83,9 @@ bool cfg_gold_drop_vanilla = true;
 bool cfg_no_ghost = false;
 bool cfg_ai_learn = true;
 bool cfg_challenging_levels = false;
+int16_t cfg_catch_up_frames = 0;
+bool cfg_shed_load = true;
+int16_t cfg_dormant_distance = 40;
 
 
 static const char *slots[] =
@@ -4887,6 +4890,7 @@ extern struct init_module mon_make_module;
 extern struct init_module obj_make_module;
 extern struct init_module ignore_module;
 extern struct init_module store_module;
+extern struct init_module effects_module;
 extern struct init_module ui_visuals_module;
 
 
@@ -4901,6 +4905,7 @@ static struct init_module *modules[] =
     &obj_make_module,
     &ignore_module,
     &store_module,
+    &effects_module,
     NULL
 };
 
@@ -5041,11 +5046,17 @@ void cleanup_angband(void)
     /* Free the format() buffer */
     vformat_kill();
 
+    /* Free the project() buffers */
+    free_project_scratch();
+
     /* Free the directories */
     free_file_paths();
 
     /* Stop the network server */
     Stop_net_server();
+
+    /* Free the object pools (the players are gone now) */
+    free_object_pools();
 }
 
 
@@ -5112,6 +5123,20 @@ static void set_server_option(const char *option, char *value)
         /* Reinstall the timer handler to match the new FPS */
         install_timer_tick(run_game_loop, cfg_fps);
     }
+    else if (streq(option, "CATCH_UP_FRAMES"))
+    {
+        cfg_catch_up_frames = atoi(value);
+        if (cfg_catch_up_frames < 0) cfg_catch_up_frames = 0;
+        if (cfg_catch_up_frames > 10) cfg_catch_up_frames = 10;
+    }
+    else if (streq(option, "SHED_LOAD"))
+        cfg_shed_load = str_to_boolean(value);
+    else if (streq(option, "DORMANT_DISTANCE"))
+    {
+        cfg_dormant_distance = atoi(value);
+        if (cfg_dormant_distance < 0) cfg_dormant_distance = 0;
+        if (cfg_dormant_distance > 255) cfg_dormant_distance = 255;
+    }
     else if (streq(option, "MAX_ACCOUNT_CHARS"))
     {
         cfg_max_account_chars = atoi(value);
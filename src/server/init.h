@@ -63,6 +63,9 @@ extern bool cfg_gold_drop_vanilla;
 extern bool cfg_no_ghost;
 extern bool cfg_ai_learn;
 extern bool cfg_challenging_levels;
+extern int16_t cfg_catch_up_frames;
+extern bool cfg_shed_load;
+extern int16_t cfg_dormant_distance;
 
 extern const char *list_obj_flag_names[];
 extern const char *obj_mods[];
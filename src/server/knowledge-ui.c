@@ -1935,6 +1935,9 @@ void do_cmd_redraw(struct player *p)
     /* Combine the pack (later) */
     p->upkeep->notice |= (PN_COMBINE);
 
+    /* Describe all items again */
+    item_cache_invalidate(p);
+
     /* Update stuff */
     p->upkeep->update |= (PU_BONUS | PU_SPELLS | PU_INVEN);
 
@@ -2869,6 +2872,7 @@ void do_cmd_monlist(struct player *p)
 
     /* Notify player */
     notify_player(p, "Monster List", NTERM_WIN_MONLIST, true);
+    monster_list_invalidate(p);
 }
 
 
@@ -2882,6 +2886,7 @@ void do_cmd_itemlist(struct player *p)
 
     /* Notify player */
     notify_player(p, "Object List", NTERM_WIN_OBJLIST, true);
+    object_list_invalidate(p);
 }
 
 
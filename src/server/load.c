@@ -224,7 +224,7 @@ static struct object *rd_item(void)
     rd_byte(&tmp8u);
     if (tmp8u)
     {
-        obj->curses = mem_zalloc(z_info->curse_max * sizeof(struct curse_data));
+        obj->curses = object_curses_new();
 
         for (i = 0; i < (size_t)curse_max; i++)
         {
@@ -1414,7 +1414,10 @@ static int rd_player_objects_aux(struct player *p, rd_item_t rd_item_version)
 
         /* Place object in player object list */
         if (player_square_in_bounds_fully(p, &obj->grid))
+        {
             pile_insert_end(&square_p(p, &obj->grid)->obj, obj);
+            square_list_pile(p, &obj->grid);
+        }
     }
 
     return 0;
@@ -1509,6 +1512,9 @@ static bool rd_monster_aux(struct chunk *c, struct monster *mon, rd_item_t rd_it
     for (j = 0; j < (size_t)mflag_size; j++)
         rd_byte(&mon->mflag[j]);
 
+    /* The player steps of the level aren't saved: dormant monsters start awake */
+    mflag_off(mon->mflag, MFLAG_DORMANT);
+
     for (j = 0; j < (size_t)of_size; j++)
         rd_byte(&mon->known_pstate.flags[j]);
 
@@ -266,12 +266,32 @@ int main(int argc, char *argv[])
             case 'v':
                 show_version();
 
+            case 's':
+                soak_seed = (uint32_t)atol(&argv[0][2]);
+                break;
+
+            case 'b':
+                soak_bots = atoi(&argv[0][2]);
+                break;
+
+            case 'n':
+                soak_frames = atoi(&argv[0][2]);
+                break;
+
+            case 'h':
+                soak_hounds = atoi(&argv[0][2]);
+                break;
+
             default:
                 usage:
 
                 /* Note -- the Term is NOT initialized */
                 puts("Usage: mangband [options]");
-                puts("  -v   Show version");
+                puts("  -v          Show version");
+                puts("  -s<seed>    Use a fixed RNG seed");
+                puts("  -b<num>     Run the soak benchmark with <num> scripted bots");
+                puts("  -n<frames>  Stop the soak benchmark after <frames> frames");
+                puts("  -h<num>     Summon packs of <num> hounds next to the soak benchmark bots");
 
                 /* Actually abort the process */
                 quit(NULL);
@@ -309,6 +329,12 @@ int main(int argc, char *argv[])
     /* Initialize the basics */
     init_angband();
 
+    /* Use a fixed seed */
+    if (soak_seed) Rand_state_init(soak_seed);
+
+    /* Prepare the soak benchmark */
+    if (soak_bots) soak_init();
+
     /* Play the game */
     play_game();
 
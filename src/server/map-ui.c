@@ -861,12 +861,14 @@ void grid_data_as_text(struct player *p, struct chunk *cv, bool server, struct g
  * Redraw (on the screen) the current map panel.
  *
  * The main screen will always be at least 24x80 in size.
+ *
+ * When "cached" is true (the panel just moved), grids that did not change are taken from the
+ * glyph cache.
  */
-void prt_map(struct player *p)
+void prt_map(struct player *p, bool cached)
 {
     uint16_t a, ta;
     char c, tc;
-    struct grid_data g;
     struct loc grid;
     int vy, vx;
     int ty, tx;
@@ -883,24 +885,28 @@ void prt_map(struct player *p)
     /* Dump the map */
     for (grid.y = p->offset_grid.y, vy = 1; grid.y < ty; vy++, grid.y++)
     {
-        /* First clear the old stuff */
-        for (grid.x = 0; grid.x < z_info->dungeon_wid; grid.x++)
+        /* First clear the old stuff past the screen */
+        if (screen_wid < z_info->dungeon_wid)
         {
-            p->scr_info[vy][grid.x].c = 0;
-            p->scr_info[vy][grid.x].a = 0;
-            p->trn_info[vy][grid.x].c = 0;
-            p->trn_info[vy][grid.x].a = 0;
+            memset(&p->scr_info[vy][screen_wid], 0,
+                (z_info->dungeon_wid - screen_wid) * sizeof(cave_view_type));
+            memset(&p->trn_info[vy][screen_wid], 0,
+                (z_info->dungeon_wid - screen_wid) * sizeof(cave_view_type));
         }
 
         /* Scan the columns of row "y" */
         for (grid.x = p->offset_grid.x, vx = 0; grid.x < tx; vx++, grid.x++)
         {
             /* Check bounds */
-            if (!square_in_bounds(cv, &grid)) continue;
+            if (!square_in_bounds(cv, &grid))
+            {
+                memset(&p->scr_info[vy][vx], 0, sizeof(cave_view_type));
+                memset(&p->trn_info[vy][vx], 0, sizeof(cave_view_type));
+                continue;
+            }
 
             /* Determine what is there */
-            map_info(p, cv, &grid, &g);
-            grid_data_as_text(p, cv, false, &g, &a, &c, &ta, &tc);
+            map_glyph(p, cv, &grid, cached, &a, &c, &ta, &tc);
 
             p->scr_info[vy][vx].c = c;
             p->scr_info[vy][vx].a = a;
@@ -341,12 +341,14 @@ static void monster_list_get_glyphs(struct player *p, monster_list_t *list)
  *
  * height is the height of the list.
  * width is the width of the list.
+ *
+ * Returns true if the list changed since it was last sent to the subwindow.
  */
-void monster_list_show_subwindow(struct player *p, int height, int width)
+bool monster_list_show_subwindow(struct player *p, int height, int width)
 {
 	monster_list_t *list;
 
-    if ((height < 1) || (width < 1)) return;
+    if ((height < 1) || (width < 1)) return false;
 
     list = monster_list_shared_instance(p);
 
@@ -366,6 +368,9 @@ void monster_list_show_subwindow(struct player *p, int height, int width)
 
     /* Restore height and width of current dungeon level */
     text_out_done(p);
+
+    /* Nothing to send if the list looks the same */
+    return text_out_changed(p, &list->sent, height, width);
 }
 
 
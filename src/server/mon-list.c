@@ -42,6 +42,7 @@ monster_list_t *monster_list_new(struct player *p)
 	}
 
 	list->entries_size = size;
+    list->race_entry = mem_zalloc(z_info->r_max * sizeof(uint16_t));
 
 	return list;
 }
@@ -54,6 +55,8 @@ void monster_list_free(monster_list_t *list)
 {
 	if (list == NULL) return;
 	mem_free(list->entries);
+    mem_free(list->race_entry);
+    text_out_copy_free(&list->sent);
 	mem_free(list);
 }
 
@@ -89,6 +92,17 @@ monster_list_t *monster_list_shared_instance(struct player *p)
 }
 
 
+/*
+ * Force the next subwindow update to be sent, even if the list didn't change.
+ */
+void monster_list_invalidate(struct player *p)
+{
+    monster_list_t *list = (monster_list_t *)p->monster_list_subwindow;
+
+    if (list) text_out_copy_free(&list->sent);
+}
+
+
 /*
  * Return true if there is nothing preventing the list from being updated. This
  * should be for structural sanity checks and not gameplay checks.
@@ -104,20 +118,28 @@ static bool monster_list_can_update(monster_list_t *list, struct chunk *c)
 /*
  * Zero out the contents of a monster list. If needed, this function will
  * reallocate the entry list if the number of monsters has changed.
+ *
+ * Only the entries used by the last collect are cleared.
  */
 void monster_list_reset(struct player *p, monster_list_t *list)
 {
     struct chunk *c = chunk_get(&p->wpos);
+    int i;
 
     if ((list == NULL) || (list->entries == NULL)) return;
 
+    for (i = 0; i < list->distinct_entries; i++)
+        list->race_entry[list->entries[i].race->ridx] = 0;
+
     if ((int)list->entries_size < cave_monster_max(c))
     {
         list->entries = mem_realloc(list->entries, sizeof(list->entries[0]) * cave_monster_max(c));
         list->entries_size = cave_monster_max(c);
+        memset(list->entries, 0, list->entries_size * sizeof(monster_list_entry_t));
     }
+    else
+        memset(list->entries, 0, list->distinct_entries * sizeof(monster_list_entry_t));
 
-    memset(list->entries, 0, list->entries_size * sizeof(monster_list_entry_t));
     memset(list->total_entries, 0, MONSTER_LIST_SECTION_MAX * sizeof(uint16_t));
     memset(list->total_monsters, 0, MONSTER_LIST_SECTION_MAX * sizeof(uint16_t));
     list->distinct_entries = 0;
@@ -127,10 +149,12 @@ void monster_list_reset(struct player *p, monster_list_t *list)
 
 /*
  * Collect monster information from the current cave's monster list.
+ *
+ * Entries are filled in order, and race_entry[] finds the entry of a race already listed.
  */
 void monster_list_collect(struct player *p, monster_list_t *list)
 {
-	int i;
+	int i, used = 0;
     struct chunk *c = chunk_get(&p->wpos);
 
 	if (!monster_list_can_update(list, c)) return;
@@ -139,8 +163,8 @@ void monster_list_collect(struct player *p, monster_list_t *list)
 	for (i = 1; i < cave_monster_max(c); i++)
     {
 		struct monster *mon = cave_monster(c, i);
-		monster_list_entry_t *entry = NULL;
-		int j, field;
+		monster_list_entry_t *entry;
+		int field;
 		bool los = false;
 
         /* Skip dead monsters */
@@ -153,25 +177,18 @@ void monster_list_collect(struct player *p, monster_list_t *list)
         if (!monster_is_obvious(p, i, mon)) continue;
 
 		/* Find or add a list entry. */
-		for (j = 0; j < (int)list->entries_size; j++)
+        if (list->race_entry[mon->race->ridx])
+            entry = &list->entries[list->race_entry[mon->race->ridx] - 1];
+        else
         {
-			if (list->entries[j].race == NULL)
-            {
-				/* We found an empty slot, so add this race here. */
-                entry = &list->entries[j];
-                memset(entry, 0, sizeof(monster_list_entry_t));
-				entry->race = mon->race;
-				break;
-			}
-			else if (list->entries[j].race == mon->race)
-            {
-				/* We found a matching race and we'll use that. */
-				entry = &list->entries[j];
-				break;
-			}
-		}
-
-		if (entry == NULL) continue;
+            if (used == (int)list->entries_size) continue;
+
+            /* Add this race in the next empty slot */
+            entry = &list->entries[used++];
+            memset(entry, 0, sizeof(monster_list_entry_t));
+            entry->race = mon->race;
+            list->race_entry[mon->race->ridx] = (uint16_t)used;
+        }
 
         /* Always collect the latest monster attribute so that flicker animation works. */
         if (p->tile_distorted)
@@ -180,8 +197,8 @@ void monster_list_collect(struct player *p, monster_list_t *list)
             entry->attr = mon->attr;
 
 		/* Check for LOS using projectable() */
-		los = (projectable(p, c, &p->grid, &mon->grid, PROJECT_NONE, true) &&
-            monster_is_in_view(p, i));
+		los = (monster_is_in_view(p, i) &&
+            projectable(p, c, &p->grid, &mon->grid, PROJECT_NONE, true));
 		field = (los? MONSTER_LIST_SECTION_LOS: MONSTER_LIST_SECTION_ESP);
 		entry->count[field]++;
 
@@ -194,10 +211,8 @@ void monster_list_collect(struct player *p, monster_list_t *list)
 	}
 
 	/* Collect totals for easier calculations of the list. */
-	for (i = 0; i < (int)list->entries_size; i++)
+	for (i = 0; i < used; i++)
     {
-		if (list->entries[i].race == NULL) continue;
-
 		if (list->entries[i].count[MONSTER_LIST_SECTION_LOS] > 0)
 			list->total_entries[MONSTER_LIST_SECTION_LOS]++;
 
@@ -22,6 +22,8 @@ typedef struct monster_list_entry_s
 	uint8_t attr;
 } monster_list_entry_t;
 
+struct text_out_copy;
+
 typedef struct monster_list_s
 {
 	monster_list_entry_t *entries;
@@ -30,6 +32,8 @@ typedef struct monster_list_s
     bool sorted;
 	uint16_t total_entries[MONSTER_LIST_SECTION_MAX];
 	uint16_t total_monsters[MONSTER_LIST_SECTION_MAX];
+    uint16_t *race_entry;   /* Entry of each race, plus one (0 if the race isn't listed) */
+    struct text_out_copy *sent; /* List last sent to the subwindow (NULL to force an update) */
 } monster_list_t;
 
 extern monster_list_t *monster_list_new(struct player *p);
@@ -37,6 +41,7 @@ extern void monster_list_free(monster_list_t *list);
 extern void monster_list_init(struct player *p);
 extern void monster_list_finalize(struct player *p);
 extern monster_list_t *monster_list_shared_instance(struct player *p);
+extern void monster_list_invalidate(struct player *p);
 extern void monster_list_reset(struct player *p, monster_list_t *list);
 extern void monster_list_collect(struct player *p, monster_list_t *list);
 extern int monster_list_standard_compare(const void *a, const void *b);
@@ -31,9 +31,9 @@
  * - prob2 is calculated by get_mon_num_prep(), which decides whether a
  *         monster is appropriate based on a secondary function; prob2 is
  *         always either prob1 or 0.
- * - prob3 is calculated by get_mon_num(), which checks whether universal
- *         restrictions apply (for example, unique monsters can only appear
- *         once on a given level); prob3 is always either prob2 or 0.
+ * - prob3 is not used: get_mon_num() checks whether universal restrictions
+ *         apply (for example, unique monsters can only appear once on a given
+ *         level) when building its cached distributions (see below).
  */
 
 
@@ -41,6 +41,64 @@ static int16_t alloc_race_size;
 static alloc_entry *alloc_race_table;
 
 
+/*
+ * Cached monster distributions
+ *
+ * The races allowed by get_mon_num() only depend on the generated level, the summon flag, the
+ * location (town, wilderness, dungeon rules) and the restriction set by get_mon_num_prep(),
+ * except for uniques which also depend on the players on the level and on the uniques already
+ * generated or killed. For each combination of the former, the non-unique races are stored in
+ * a Walker/Vose alias table so that picking one takes constant time; uniques are kept in a
+ * separate (short) list and checked on each call. The last MON_ALLOC_CACHE_SIZE distributions
+ * are cached.
+ *
+ * Restrictions depend on the hook and on whatever it reads (summon type, kin, pit race...), so
+ * restricted distributions are not cached: they are rebuilt on each call and a race is picked
+ * by scanning the probabilities.
+ */
+
+
+/* Number of cached distributions */
+#define MON_ALLOC_CACHE_SIZE    16
+
+
+struct mon_alloc
+{
+    /* Key */
+    struct worldpos wpos;   /* Location */
+    int level;              /* Generated level */
+    bool summon;            /* Summoned monsters (no dungeon rules) */
+    bool poly;              /* Rings of polymorphing (see get_mon_num_poly()) */
+    uint32_t stamp;         /* Last use (0 = empty slot) */
+    bool direct;            /* Restricted distribution (not cached, no alias table) */
+
+    /* Non-unique races */
+    int num;                /* Number of races */
+    uint32_t total;         /* Total probability */
+    int16_t *race;          /* Race index of each entry */
+    uint32_t *cut;          /* Keep the entry if randint0(total) < cut, else take the alias
+                             * (probability of the entry if direct) */
+    int16_t *alias;         /* Alias of each entry */
+
+    /* Uniques */
+    int num_uniques;        /* Number of uniques */
+    int16_t *unique;        /* Race index of each unique */
+    uint32_t *unique_prob;  /* Probability of each unique */
+};
+
+
+static struct mon_alloc mon_alloc_cache[MON_ALLOC_CACHE_SIZE];
+static uint32_t mon_alloc_stamp;
+
+
+/* Restricted distribution */
+static struct mon_alloc mon_alloc_direct;
+
+
+/* A restriction is set by get_mon_num_prep() */
+static bool mon_alloc_hook;
+
+
 /*
  * Initialize monster allocation info
  */
@@ -133,8 +191,24 @@ static void init_race_allocs(void)
 }
 
 
+static void free_mon_alloc(struct mon_alloc *alloc)
+{
+    mem_free(alloc->race);
+    mem_free(alloc->cut);
+    mem_free(alloc->alias);
+    mem_free(alloc->unique);
+    mem_free(alloc->unique_prob);
+    memset(alloc, 0, sizeof(*alloc));
+}
+
+
 static void cleanup_race_allocs(void)
 {
+    int i;
+
+    for (i = 0; i < MON_ALLOC_CACHE_SIZE; i++) free_mon_alloc(&mon_alloc_cache[i]);
+    free_mon_alloc(&mon_alloc_direct);
+
     mem_free(alloc_race_table);
     alloc_race_table = NULL;
 }
@@ -150,6 +224,9 @@ void get_mon_num_prep(bool (*get_mon_num_hook)(struct monster_race *race))
 {
     int i;
 
+    /* The cached distributions don't apply to a restriction */
+    mon_alloc_hook = (get_mon_num_hook != NULL);
+
     /* Scan the allocation table */
     for (i = 0; i < alloc_race_size; i++)
     {
@@ -183,32 +260,6 @@ void get_mon_num_prep(bool (*get_mon_num_hook)(struct monster_race *race))
 }
 
 
-/*
- * Helper function for get_mon_num(). Scans the prepared monster allocation
- * table and picks a random monster. Returns the index of a monster in
- * `table`.
- */
-static struct monster_race *get_mon_race_aux(long total, const alloc_entry *table)
-{
-    int i;
-
-    /* Pick a monster */
-    long value = randint0(total);
-
-    /* Find the monster */
-    for (i = 0; i < alloc_race_size; i++)
-    {
-        /* Found the entry */
-        if (value < table[i].prob3) break;
-
-        /* Decrement */
-        value -= table[i].prob3;
-    }
-
-    return &r_info[table[i].index];
-}
-
-
 /* Scan all players on the level and see if at least one can find the unique */
 static bool allow_unique_level(struct monster_race *race, struct worldpos *wpos)
 {
@@ -295,13 +346,9 @@ static int restrict_monster_to_dungeon(struct monster_race *race, struct worldpo
 }
 
 
-/* Checks if a monster race can be generated at that location */
-static bool allow_race(struct monster_race *race, struct worldpos *wpos)
+/* Checks if a monster race can be generated at that location (ignoring uniques already around) */
+static bool allow_race_location(struct monster_race *race, struct worldpos *wpos)
 {
-    /* Only one copy of a unique must be around at the same time */
-    if (race_is_unique(race) && !allow_unique_level(race, wpos))
-        return false;
-
     /* Some monsters never appear out of depth */
     if (rf_has(race->flags, RF_FORCE_DEPTH) && (race->level > wpos->depth))
         return false;
@@ -326,6 +373,17 @@ static bool allow_race(struct monster_race *race, struct worldpos *wpos)
 }
 
 
+/* Checks if a monster race can be generated at that location */
+static bool allow_race(struct monster_race *race, struct worldpos *wpos)
+{
+    /* Only one copy of a unique must be around at the same time */
+    if (race_is_unique(race) && !allow_unique_level(race, wpos))
+        return false;
+
+    return allow_race_location(race, wpos);
+}
+
+
 static bool limit_townies(struct chunk *c)
 {
     int max_townies;
@@ -339,15 +397,197 @@ static bool limit_townies(struct chunk *c)
 }
 
 
+/*
+ * Get the probability of a race in a distribution (ignoring uniques already around)
+ */
+static uint32_t mon_alloc_prob(const alloc_entry *entry, struct worldpos *wpos, bool summon,
+    bool poly)
+{
+    struct monster_race *race = &r_info[entry->index];
+    int p;
+    uint32_t prob;
+
+    /* Rings of polymorphing: no town monsters, no uniques */
+    if (poly)
+    {
+        if ((entry->level <= 0) || race_is_unique(race)) return 0;
+
+        /* Pick from specific dungeon */
+        if (!allow_location(race, wpos)) return 0;
+
+        /* Handle PWMAngband base monsters */
+        if (rf_has(race->flags, RF_PWMANG_BASE) && !cfg_base_monsters) return 0;
+
+        /* Handle PWMAngband extra monsters */
+        if (rf_has(race->flags, RF_PWMANG_EXTRA) && !cfg_extra_monsters) return 0;
+
+        return entry->prob2;
+    }
+
+    /* No town monsters outside of towns */
+    if (!in_town(wpos) && (entry->level <= 0)) return 0;
+
+    /* Check if monster race can be generated at that location */
+    if (!allow_race_location(race, wpos)) return 0;
+
+    /* Some dungeon types restrict the possible monsters (except for summons) */
+    p = (summon? 10000: restrict_monster_to_dungeon(race, wpos));
+    prob = entry->prob2 * p / 10000;
+    if (p && entry->prob2 && !prob) prob = 1;
+
+    return prob;
+}
+
+
+/*
+ * Get the distribution of races for the given parameters, building it if necessary
+ */
+static struct mon_alloc *mon_alloc_get(struct worldpos *wpos, int level, bool summon, bool poly)
+{
+    struct mon_alloc *alloc = &mon_alloc_cache[0];
+    int i;
+
+    /* Restricted distributions are always rebuilt */
+    if (mon_alloc_hook) alloc = &mon_alloc_direct;
+
+    /* Look for a cached distribution, else replace the least recently used one */
+    else
+    {
+        for (i = 0; i < MON_ALLOC_CACHE_SIZE; i++)
+        {
+            struct mon_alloc *slot = &mon_alloc_cache[i];
+
+            if (slot->stamp && wpos_eq(&slot->wpos, wpos) && (slot->level == level) &&
+                (slot->summon == summon) && (slot->poly == poly))
+            {
+                slot->stamp = ++mon_alloc_stamp;
+                return slot;
+            }
+
+            if (slot->stamp < alloc->stamp) alloc = slot;
+        }
+    }
+
+    if (!alloc->race)
+    {
+        alloc->race = mem_zalloc(alloc_race_size * sizeof(int16_t));
+        alloc->cut = mem_zalloc(alloc_race_size * sizeof(uint32_t));
+        alloc->alias = mem_zalloc(alloc_race_size * sizeof(int16_t));
+        alloc->unique = mem_zalloc(alloc_race_size * sizeof(int16_t));
+        alloc->unique_prob = mem_zalloc(alloc_race_size * sizeof(uint32_t));
+    }
+
+    memcpy(&alloc->wpos, wpos, sizeof(struct worldpos));
+    alloc->level = level;
+    alloc->summon = summon;
+    alloc->poly = poly;
+    alloc->stamp = ++mon_alloc_stamp;
+    alloc->direct = mon_alloc_hook;
+    alloc->num = 0;
+    alloc->total = 0;
+    alloc->num_uniques = 0;
+
+    /* Process probabilities */
+    for (i = 0; i < alloc_race_size; i++)
+    {
+        alloc_entry *entry = &alloc_race_table[i];
+        uint32_t prob;
+
+        /* Monsters are sorted by depth */
+        if (entry->level > level) break;
+
+        prob = mon_alloc_prob(entry, wpos, summon, poly);
+        if (!prob) continue;
+
+        /* Uniques are checked on each call */
+        if (race_is_unique(&r_info[entry->index]))
+        {
+            alloc->unique[alloc->num_uniques] = entry->index;
+            alloc->unique_prob[alloc->num_uniques] = prob;
+            alloc->num_uniques++;
+            continue;
+        }
+
+        alloc->race[alloc->num] = entry->index;
+        alloc->cut[alloc->num] = prob;
+        alloc->num++;
+        alloc->total += prob;
+    }
+
+    /* Build the alias table, unless the distribution is only used once */
+    if (!alloc->direct) Rand_alias_init(alloc->cut, alloc->alias, alloc->num, alloc->total);
+
+    return alloc;
+}
+
+
+/*
+ * Get the total probability of the uniques that can be generated at that location
+ */
+static uint32_t mon_alloc_uniques(struct mon_alloc *alloc, struct worldpos *wpos)
+{
+    uint32_t total = 0;
+    int i;
+
+    for (i = 0; i < alloc->num_uniques; i++)
+    {
+        if (allow_unique_level(&r_info[alloc->unique[i]], wpos)) total += alloc->unique_prob[i];
+    }
+
+    return total;
+}
+
+
+/*
+ * Pick a race from a distribution ("uniques" is the total probability of the uniques allowed)
+ */
+static struct monster_race *mon_alloc_pick(struct mon_alloc *alloc, struct worldpos *wpos,
+    uint32_t uniques)
+{
+    uint32_t value = randint0(alloc->total + uniques);
+    int i;
+
+    /* Pick a non-unique race */
+    if (value < alloc->total)
+    {
+        /* Restricted distribution: scan the probabilities */
+        if (alloc->direct)
+        {
+            for (i = 0; value >= alloc->cut[i]; i++) value -= alloc->cut[i];
+            return &r_info[alloc->race[i]];
+        }
+
+        /* The value is also a fair draw for the cut */
+        i = randint0(alloc->num);
+        if (value >= alloc->cut[i]) i = alloc->alias[i];
+        return &r_info[alloc->race[i]];
+    }
+
+    /* Pick a unique */
+    value -= alloc->total;
+    for (i = 0; i < alloc->num_uniques; i++)
+    {
+        struct monster_race *race = &r_info[alloc->unique[i]];
+
+        if (!allow_unique_level(race, wpos)) continue;
+        if (value < alloc->unique_prob[i]) return race;
+        value -= alloc->unique_prob[i];
+    }
+
+    /* Paranoia */
+    return NULL;
+}
+
+
 /*
  * Chooses a monster race that seems "appropriate" to the given level
  *
  * generated_level is the level to use when choosing the race.
  *
  * This function uses the "prob2" field of the "monster allocation table",
- * and various local information, to calculate the "prob3" field of the
- * same table, which is then used to choose an "appropriate" monster, in
- * a relatively efficient manner.
+ * and various local information, to build a distribution of races (cached
+ * for the next calls with the same parameters), which is then used to choose
+ * an "appropriate" monster in constant time (plus a check of the uniques).
  *
  * Note that "town" monsters will *only* be created in the towns, and
  * "normal" monsters will *never* be created in the towns.
@@ -364,10 +604,10 @@ static bool limit_townies(struct chunk *c)
  */
 struct monster_race *get_mon_num(struct chunk *c, int generated_level, bool summon)
 {
-    int i, p;
-    long total;
+    int p;
+    uint32_t uniques;
     struct monster_race *race;
-    alloc_entry *table = alloc_race_table;
+    struct mon_alloc *alloc;
 
     /* No monsters in the base town (no_recall servers) */
     if ((cfg_diving_mode == 3) && in_base_town(&c->wpos)) return (0);
@@ -385,43 +625,15 @@ struct monster_race *get_mon_num(struct chunk *c, int generated_level, bool summ
     if ((c->wpos.depth > 0) && one_in_(z_info->ood_monster_chance))
         generated_level += MIN(generated_level / 4 + 2, z_info->ood_monster_amount);
 
-    total = 0L;
-
-    /* Process probabilities */
-    for (i = 0; i < alloc_race_size; i++)
-    {
-        /* Monsters are sorted by depth */
-        if (table[i].level > generated_level) break;
-
-        /* Default */
-        table[i].prob3 = 0;
-
-        /* No town monsters outside of towns */
-        if (!in_town(&c->wpos) && (table[i].level <= 0)) continue;
-
-        /* Get the chosen monster */
-        race = &r_info[table[i].index];
-
-        /* Check if monster race can be generated at that location */
-        if (!allow_race(race, &c->wpos)) continue;
-
-        /* Accept */
-        table[i].prob3 = table[i].prob2;
-
-        /* Some dungeon types restrict the possible monsters (except for summons) */
-        p = (summon? 10000: restrict_monster_to_dungeon(race, &c->wpos));
-        table[i].prob3 = table[i].prob3 * p / 10000;
-        if (p && table[i].prob2 && !table[i].prob3) table[i].prob3 = 1;
-
-        /* Total */
-        total += table[i].prob3;
-    }
+    /* Get the distribution */
+    alloc = mon_alloc_get(&c->wpos, generated_level, summon, false);
+    uniques = mon_alloc_uniques(alloc, &c->wpos);
 
     /* No legal monsters */
-    if (total <= 0) return NULL;
+    if (!alloc->total && !uniques) return NULL;
 
     /* Pick a monster */
-    race = get_mon_race_aux(total, table);
+    race = mon_alloc_pick(alloc, &c->wpos, uniques);
 
     /* Always try for a "harder" monster if too weak */
     if (race->level < (generated_level / 2))
@@ -429,7 +641,7 @@ struct monster_race *get_mon_num(struct chunk *c, int generated_level, bool summ
         struct monster_race *old = race;
 
         /* Pick a new monster */
-        race = get_mon_race_aux(total, table);
+        race = mon_alloc_pick(alloc, &c->wpos, uniques);
 
         /* Keep the deepest one */
         if (race->level < old->level) race = old;
@@ -441,7 +653,7 @@ struct monster_race *get_mon_num(struct chunk *c, int generated_level, bool summ
         struct monster_race *old = race;
 
         /* Pick a new monster */
-        race = get_mon_race_aux(total, table);
+        race = mon_alloc_pick(alloc, &c->wpos, uniques);
 
         /* Keep the deepest one */
         if (race->level < old->level) race = old;
@@ -454,7 +666,7 @@ struct monster_race *get_mon_num(struct chunk *c, int generated_level, bool summ
         struct monster_race *old = race;
 
         /* Pick a new monster */
-        race = get_mon_race_aux(total, table);
+        race = mon_alloc_pick(alloc, &c->wpos, uniques);
 
         /* Keep the deepest one */
         if (race->level < old->level) race = old;
@@ -466,7 +678,7 @@ struct monster_race *get_mon_num(struct chunk *c, int generated_level, bool summ
         struct monster_race *old = race;
 
         /* Pick a new monster */
-        race = get_mon_race_aux(total, table);
+        race = mon_alloc_pick(alloc, &c->wpos, uniques);
 
         /* Keep the deepest one */
         if (race->level < old->level) race = old;
@@ -483,57 +695,13 @@ struct monster_race *get_mon_num(struct chunk *c, int generated_level, bool summ
  */
 struct monster_race *get_mon_num_poly(struct worldpos *wpos)
 {
-    int i, level = wpos->depth;
-    long total;
-    struct monster_race *race;
-    alloc_entry *table = alloc_race_table;
-
-    total = 0L;
-
-    /* Process probabilities */
-    for (i = 0; i < alloc_race_size; i++)
-    {
-        /* Monsters are sorted by depth */
-        if (table[i].level > level) break;
-
-        /* Default */
-        table[i].prob3 = 0;
-
-        /* No town monsters */
-        if (table[i].level <= 0) continue;
-
-        /* Get the chosen monster */
-        race = &r_info[table[i].index];
-
-        /* Skip uniques */
-        if (race_is_unique(race)) continue;
-
-        /* Pick from specific dungeon */
-        if (!allow_location(race, wpos)) continue;
-
-        /* Handle PWMAngband base monsters */
-        if (rf_has(race->flags, RF_PWMANG_BASE) && !cfg_base_monsters)
-            continue;
-
-        /* Handle PWMAngband extra monsters */
-        if (rf_has(race->flags, RF_PWMANG_EXTRA) && !cfg_extra_monsters)
-            continue;
-
-        /* Accept */
-        table[i].prob3 = table[i].prob2;
-
-        /* Total */
-        total += table[i].prob3;
-    }
+    struct mon_alloc *alloc = mon_alloc_get(wpos, wpos->depth, false, true);
 
     /* No legal monsters */
-    if (total <= 0) return NULL;
+    if (!alloc->total) return NULL;
 
     /* Pick a monster */
-    race = get_mon_race_aux(total, table);
-
-    /* Result */
-    return race;
+    return mon_alloc_pick(alloc, wpos, 0);
 }
 
 
@@ -833,6 +1001,9 @@ void compact_monsters(struct chunk *c, int num_to_compact)
         /* Compress "cave->mon_max" */
         c->mon_max--;
     }
+
+    /* Monster indexes have changed */
+    c->mon_ready_num = 0;
 }
 
 
@@ -909,6 +1080,7 @@ void wipe_mon_list(struct chunk *c)
 
     /* Reset "mon_cnt" */
     c->mon_cnt = 0;
+    c->mon_ready_num = 0;
 
     /* Reset the number of clones */
     c->num_repro = 0;
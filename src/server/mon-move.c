@@ -747,6 +747,53 @@ static bool get_move_advance(struct player *p, struct chunk *c, struct monster *
 }
 
 
+/*
+ * Safe and hiding places
+ *
+ * Looking for a place out of the player's view means scanning up to 9 rings of grids around
+ * the monster, which is expensive when a whole pack is fleeing or hiding every turn. The
+ * player's view (maintained by update_view()) already tells which grids are covered, so the
+ * place found is remembered and reused until the player moves, the monster gets there, or the
+ * place stops being suitable.
+ */
+enum
+{
+    COVER_NONE = 0,
+    COVER_SAFETY,
+    COVER_HIDING
+};
+
+
+/*
+ * Check if the last place found by a monster is still good
+ */
+static bool cover_is_cached(struct player *p, struct chunk *c, struct monster *mon, uint8_t type)
+{
+    /* The player has moved or the monster has reached its goal */
+    if ((mon->cover_type != type) || (mon->cover_player != p->id)) return false;
+    if (!loc_eq(&mon->cover_from, &p->grid) || loc_eq(&mon->cover_grid, &mon->grid)) return false;
+
+    /* The place is not covered anymore */
+    if (square_isview(p, &mon->cover_grid)) return false;
+
+    /* The place is not available anymore */
+    if (type == COVER_HIDING) return square_isemptyfloor(c, &mon->cover_grid);
+    return (square_ispassable(c, &mon->cover_grid) && !monster_hates_grid(c, mon, &mon->cover_grid));
+}
+
+
+/*
+ * Remember the place found by a monster
+ */
+static void cover_remember(struct player *p, struct monster *mon, struct loc *grid, uint8_t type)
+{
+    loc_copy(&mon->cover_grid, grid);
+    loc_copy(&mon->cover_from, &p->grid);
+    mon->cover_player = p->id;
+    mon->cover_type = type;
+}
+
+
 /*
  * Choose a "safe" location near a monster for it to run toward.
  *
@@ -766,6 +813,13 @@ static bool get_move_find_safety(struct player *p, struct chunk *c, struct monst
     const int *x_offsets;
     struct loc delta;
 
+    /* Keep running toward the same place */
+    if (cover_is_cached(p, c, mon, COVER_SAFETY))
+    {
+        loc_copy(&mon->target.grid, &mon->cover_grid);
+        return true;
+    }
+
     /* Start with adjacent locations, spread further */
     for (d = 1; d < 10; d++)
     {
@@ -821,6 +875,7 @@ static bool get_move_find_safety(struct player *p, struct chunk *c, struct monst
         {
             /* Good location */
             loc_copy(&mon->target.grid, &best);
+            cover_remember(p, mon, &best, COVER_SAFETY);
 
             /* Found safe place */
             return true;
@@ -828,6 +883,7 @@ static bool get_move_find_safety(struct player *p, struct chunk *c, struct monst
     }
 
     /* No safe place */
+    mon->cover_type = COVER_NONE;
     return false;
 }
 
@@ -848,6 +904,13 @@ static bool get_move_find_hiding(struct player *p, struct chunk *c, struct monst
     /* Closest distance to get */
     min = distance(&p->grid, &mon->grid) * 3 / 4 + 2;
 
+    /* Keep going to the same place */
+    if (cover_is_cached(p, c, mon, COVER_HIDING) && (distance(&mon->cover_grid, &p->grid) >= min))
+    {
+        loc_copy(&mon->target.grid, &mon->cover_grid);
+        return true;
+    }
+
     /* Start with adjacent locations, spread further */
     for (d = 1; d < 10; d++)
     {
@@ -873,18 +936,18 @@ static bool get_move_find_hiding(struct player *p, struct chunk *c, struct monst
             /* Skip occupied locations */
             if (!square_isemptyfloor(c, &grid)) continue;
 
-            /* Check for hidden, available grid */
-            if (!square_isview(p, &grid) && projectable(p, c, &mon->grid, &grid, PROJECT_STOP, true))
-            {
-                /* Calculate distance from player */
-                dis = distance(&grid, &p->grid);
+            /* Skip grids in view of the player */
+            if (square_isview(p, &grid)) continue;
 
-                /* Remember if closer than previous */
-                if ((dis < gdis) && (dis >= min))
-                {
-                    loc_copy(&best, &grid);
-                    gdis = dis;
-                }
+            /* Calculate distance from player */
+            dis = distance(&grid, &p->grid);
+
+            /* Remember if closer than previous and available */
+            if ((dis < gdis) && (dis >= min) &&
+                projectable(p, c, &mon->grid, &grid, PROJECT_STOP, true))
+            {
+                loc_copy(&best, &grid);
+                gdis = dis;
             }
         }
 
@@ -893,6 +956,7 @@ static bool get_move_find_hiding(struct player *p, struct chunk *c, struct monst
         {
             /* Good location */
             loc_copy(&mon->target.grid, &best);
+            cover_remember(p, mon, &best, COVER_HIDING);
 
             /* Found good place */
             return true;
@@ -900,6 +964,7 @@ static bool get_move_find_hiding(struct player *p, struct chunk *c, struct monst
     }
 
     /* No good place */
+    mon->cover_type = COVER_NONE;
     return false;
 }
 
@@ -2749,6 +2814,82 @@ static void get_closest_player(struct chunk *c, struct monster *mon)
 }
 
 
+/*
+ * Dormant monsters
+ *
+ * A sleeping monster too far away from the players to see, hear or smell them goes passive
+ * (see monster_check_active()) and doesn't even get closer to waking up. Such monsters are
+ * parked: they are skipped by energize_monsters() and process_monsters() until something could
+ * make them active again. Since distance() changes by at most 3/2 per grid moved, a player must
+ * walk at least "slack" grids on the level before any player can be in range; player arrivals
+ * and monster moves unpark the monsters right away. As a safety net, each dormant monster is
+ * also unparked once per second (staggered by index).
+ */
+
+
+/*
+ * Number of player steps counted when a player arrives on a level (more than any slack)
+ */
+#define DORMANT_ARRIVAL 256
+
+
+/*
+ * Park a passive sleeping monster if it is far enough from every player
+ */
+static bool park_monster(struct chunk *c, struct monster *mon)
+{
+    int range;
+
+    /* Dormant monsters are disabled */
+    if (!cfg_dormant_distance) return false;
+
+    /* Only hostile, sleeping, unhurt monsters */
+    if (mon->master || !mon->m_timed[MON_TMD_SLEEP] || (mon->hp < mon->maxhp)) return false;
+
+    /* Aggravation wakes up everything on the level */
+    if (player_of_has(mon->closest_player, OF_AGGRAVATE)) return false;
+
+    /* Stay out of sight and hearing range */
+    range = MAX(z_info->max_sight, mon->race->hearing) * 3 / 2;
+    range = MAX(range, cfg_dormant_distance);
+    if (mon->cdis <= range) return false;
+
+    /* Park the monster until the players have moved enough to disturb it */
+    mflag_on(mon->mflag, MFLAG_DORMANT);
+    mflag_off(mon->mflag, MFLAG_HANDLED);
+    mon->dormant_steps = c->player_steps + (mon->cdis - range) * 2 / 3;
+
+    return true;
+}
+
+
+/*
+ * Unpark a dormant monster if something may have disturbed it
+ */
+static bool unpark_monster(struct chunk *c, struct monster *mon)
+{
+    /* Nothing happened: keep the monster parked */
+    if (mon->m_timed[MON_TMD_SLEEP] && (mon->hp == mon->maxhp) &&
+        ((int32_t)(c->player_steps - mon->dormant_steps) < 0) &&
+        ((turn.turn + mon->midx) % cfg_fps))
+    {
+        return false;
+    }
+
+    mflag_off(mon->mflag, MFLAG_DORMANT);
+    return true;
+}
+
+
+/*
+ * A player moved "dist" grids on a level, or arrived on it (dist = -1)
+ */
+void wake_dormant_monsters(struct chunk *c, int dist)
+{
+    c->player_steps += ((dist < 0)? DORMANT_ARRIVAL: (uint32_t)dist);
+}
+
+
 /*
  * Process all the "live" monsters, once per game turn.
  *
@@ -2759,16 +2900,24 @@ static void get_closest_player(struct chunk *c, struct monster *mon)
  * This function and its children are responsible for a considerable fraction
  * of the processor time in normal situations, greater if the character is
  * resting.
+ *
+ * The first pass (more_energy) only looks at the monsters that had enough energy to act at the
+ * end of the previous turn (see energize_monsters()): the others can't act before the players
+ * anyway, so they are left to the second pass which still visits every monster.
+ *
+ * Dormant monsters are skipped until they are unparked (see park_monster()).
  */
 void process_monsters(struct chunk *c, bool more_energy)
 {
-    int i, j, time;
+    int i, j, k, time;
+    int max = cave_monster_max(c);
+    int num = (more_energy? c->mon_ready_num: max - 1);
 
     /* Only process some things every so often */
     bool regen;
 
     /* Process the monsters (backwards) */
-    for (i = cave_monster_max(c) - 1; i >= 1; i--)
+    for (k = 0; k < num; k++)
     {
         struct monster *mon;
         int target_m_dis;
@@ -2776,10 +2925,21 @@ void process_monsters(struct chunk *c, bool more_energy)
         struct source who_body;
         struct source *who = &who_body;
 
+        i = (more_energy? c->mon_ready[k]: max - 1 - k);
+
+        /* The monster list may have been compacted */
+        if (i >= cave_monster_max(c)) continue;
+
         /* Get a 'live' monster */
         mon = cave_monster(c, i);
         if (!mon->race) continue;
 
+        /* Not enough energy to act before the players */
+        if (more_energy && (mon->energy < move_energy(mon->wpos.depth))) continue;
+
+        /* Skip dormant monsters */
+        if (mflag_has(mon->mflag, MFLAG_DORMANT) && !unpark_monster(c, mon)) continue;
+
         /* Ignore monsters that have already been handled */
         if (mflag_has(mon->mflag, MFLAG_HANDLED)) continue;
 
@@ -2841,6 +3001,9 @@ void process_monsters(struct chunk *c, bool more_energy)
             /* For symmetry with the player, monster can take terrain damage after its turn. */
             monster_take_terrain_damage(c, mon);
         }
+
+        /* Park passive sleeping monsters far away from the players */
+        else park_monster(c, mon);
     }
 
     /* Efficiency */
@@ -2901,8 +3064,8 @@ void reset_monsters(struct chunk *c)
         /* Access the monster */
         mon = cave_monster(c, i);
 
-        /* Skip dead monsters */
-        if (!mon->race) continue;
+        /* Skip dead and dormant monsters */
+        if (!mon->race || mflag_has(mon->mflag, MFLAG_DORMANT)) continue;
 
         /* Monster is ready to go again */
         mflag_off(mon->mflag, MFLAG_HANDLED);
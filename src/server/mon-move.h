@@ -11,6 +11,7 @@ extern bool monster_hates_grid(struct chunk *c, struct monster *mon, struct loc
 extern bool multiply_monster(struct player *p, struct chunk *c, struct monster *mon);
 extern void process_monsters(struct chunk *c, bool more_energy);
 extern void reset_monsters(struct chunk *c);
+extern void wake_dormant_monsters(struct chunk *c, int dist);
 extern bool is_closest(struct player *p, struct chunk *c, struct monster *mon, bool blos,
     bool new_los, int j, int dis_to_closest, int lowhp);
 
@@ -191,6 +191,58 @@ static bool is_mimicking_ignored(struct player *p, struct monster *mon)
 }
 
 
+/*
+ * Check if a player can be tracked by monsters as their closest player
+ */
+static bool player_can_be_closest(struct player *p)
+{
+    /* Skip him if he's shopping */
+    if (in_store(p)) return false;
+
+    /* Make the dungeon master invisible to monsters */
+    if (p->dm_flags & DM_MONSTER_FRIEND) return false;
+
+    /* Skip player if dead or gone */
+    return (p->alive && !p->is_dead && !p->upkeep->new_level_method);
+}
+
+
+/*
+ * Remember a player if he's closer to a monster than the closest player found so far
+ */
+static void check_closest(struct player *p, struct monster *mon, struct chunk *c, bool *blos,
+    int *dis_to_closest, struct player **closest, int *lowhp)
+{
+    struct loc grid;
+    int d;
+    bool new_los;
+
+    if (!player_can_be_closest(p)) return;
+
+    /* If still generating the level, measure distances from the middle */
+    grid.y = (!ht_zero(&c->generated)? p->grid.y: c->height / 2);
+    grid.x = (!ht_zero(&c->generated)? p->grid.x: c->width / 2);
+
+    /* Compute distance */
+    d = distance(&grid, &mon->grid);
+
+    /* Restrict distance */
+    if (d > 255) d = 255;
+
+    /* Check if monster has LOS to the player */
+    new_los = los(c, &mon->grid, &grid);
+
+    /* Remember this player if closest */
+    if (is_closest(p, c, mon, *blos, new_los, d, *dis_to_closest, *lowhp))
+    {
+        *blos = new_los;
+        *dis_to_closest = d;
+        *closest = p;
+        *lowhp = p->chp;
+    }
+}
+
+
 /*
  * This function updates the monster record of the given monster
  *
@@ -293,26 +345,13 @@ static void update_mon_aux(struct player *p, struct monster *mon, struct chunk *
     if (d_esp > 255) d_esp = 255;
 
     /* Find the closest player */
-    if (full)
-    {
-        /* Skip him if he's shopping */
-        /* Make the dungeon master invisible to monsters */
-        /* Skip player if dead or gone */
-        if (!in_store(p) && !(p->dm_flags & DM_MONSTER_FRIEND) &&
-            p->alive && !p->is_dead && !p->upkeep->new_level_method)
-        {
-            /* Check if monster has LOS to the player */
-            bool new_los = los(c, &mon->grid, &grid);
+    if (full) check_closest(p, mon, c, blos, dis_to_closest, closest, lowhp);
 
-            /* Remember this player if closest */
-            if (is_closest(p, c, mon, *blos, new_los, d, *dis_to_closest, *lowhp))
-            {
-                *blos = new_los;
-                *dis_to_closest = d;
-                *closest = p;
-                *lowhp = p->chp;
-            }
-        }
+    /* Efficiency -- a faraway monster that is neither seen nor detected stays unseen */
+    if (cfg_limited_esp && !isDM && (d > z_info->max_sight) && !p->mon_det[mon->midx] &&
+        !monster_is_visible(p, mon->midx) && !monster_is_in_view(p, mon->midx))
+    {
+        return;
     }
 
     /* Detected */
@@ -482,6 +521,42 @@ static void update_mon_aux(struct player *p, struct monster *mon, struct chunk *
 }
 
 
+/*
+ * Remember the closest player of a monster
+ */
+static void track_closest(struct monster *mon, struct player *closest, int dis_to_closest)
+{
+    int i;
+
+    /* Controlled monsters without a target will always try to reach their master */
+    if ((mon->status == MSTATUS_CONTROLLED) && !closest)
+    {
+        struct player *p = player_from_id(mon->master);
+
+        if (p)
+        {
+            closest = p;
+            dis_to_closest = distance(&p->grid, &mon->grid);
+        }
+    }
+
+    /* Forget player status */
+    if (closest != mon->closest_player)
+    {
+        of_wipe(mon->known_pstate.flags);
+        pf_wipe(mon->known_pstate.pflags);
+        for (i = 0; i < ELEM_MAX; i++)
+            mon->known_pstate.el_info[i].res_level[0] = 0;
+    }
+
+    /* Always track closest player */
+    mon->closest_player = closest;
+
+    /* Paranoia -- make sure we found a closest player */
+    if (closest) mon->cdis = dis_to_closest;
+}
+
+
 void update_mon(struct monster *mon, struct chunk *c, bool full)
 {
     int i;
@@ -508,35 +583,7 @@ void update_mon(struct monster *mon, struct chunk *c, bool full)
     }
 
     /* Track closest player */
-    if (full)
-    {
-        /* Controlled monsters without a target will always try to reach their master */
-        if ((mon->status == MSTATUS_CONTROLLED) && !closest)
-        {
-            struct player *p = player_from_id(mon->master);
-
-            if (p)
-            {
-                closest = p;
-                dis_to_closest = distance(&p->grid, &mon->grid);
-            }
-        }
-
-        /* Forget player status */
-        if (closest != mon->closest_player)
-        {
-            of_wipe(mon->known_pstate.flags);
-            pf_wipe(mon->known_pstate.pflags);
-            for (i = 0; i < ELEM_MAX; i++)
-                mon->known_pstate.el_info[i].res_level[0] = 0;
-        }
-
-        /* Always track closest player */
-        mon->closest_player = closest;
-
-        /* Paranoia -- make sure we found a closest player */
-        if (closest) mon->cdis = dis_to_closest;
-    }
+    if (full) track_closest(mon, closest, dis_to_closest);
 
     /* Update the cursor */
     update_cursor(who);
@@ -564,6 +611,90 @@ void update_monsters(struct chunk *c, bool full)
 }
 
 
+/*
+ * Update the closest player of a monster after player "p" moved.
+ *
+ * Only "p" is checked against the current closest player, unless "p" was the closest player
+ * or that player is gone.
+ */
+static void update_closest(struct player *p, struct monster *mon, struct chunk *c)
+{
+    struct player *closest = mon->closest_player;
+    int dis_to_closest = 9999, lowhp = 9999;
+    bool blos = false;
+    int i;
+
+    /* Check the player against the current closest player */
+    if (closest && (closest != p) && wpos_eq(&closest->wpos, &mon->wpos) &&
+        !closest->upkeep->funeral && closest->placed)
+    {
+        struct player *q = closest;
+
+        closest = NULL;
+        check_closest(q, mon, c, &blos, &dis_to_closest, &closest, &lowhp);
+        if (closest && p->placed && !p->upkeep->funeral)
+            check_closest(p, mon, c, &blos, &dis_to_closest, &closest, &lowhp);
+    }
+    else
+        closest = NULL;
+
+    /* The closest player is gone: check for each player */
+    if (!closest)
+    {
+        blos = false;
+        dis_to_closest = 9999;
+        lowhp = 9999;
+        for (i = 1; i <= NumPlayers; i++)
+        {
+            struct player *q = player_get(i);
+
+            /* Skip irrelevant players */
+            if (!wpos_eq(&q->wpos, &mon->wpos)) continue;
+            if (q->upkeep->new_level_method || q->upkeep->funeral) continue;
+            if (!q->placed) continue;
+
+            check_closest(q, mon, c, &blos, &dis_to_closest, &closest, &lowhp);
+        }
+    }
+
+    track_closest(mon, closest, dis_to_closest);
+}
+
+
+/*
+ * Updates all the (non-dead) monsters as seen by one player, after that player moved or
+ * changed in a way that doesn't affect the view of other players.
+ */
+void update_monsters_for(struct player *p, struct chunk *c, bool full)
+{
+    int i;
+    bool blos = false;
+    struct player *closest = NULL;
+    int dis_to_closest = 9999, lowhp = 9999;
+    struct source who_body;
+    struct source *who = &who_body;
+    bool relevant = (wpos_eq(&p->wpos, &c->wpos) && !p->upkeep->new_level_method &&
+        !p->upkeep->funeral && p->placed);
+
+    for (i = 1; i < cave_monster_max(c); i++)
+    {
+        struct monster *mon = cave_monster(c, i);
+
+        /* Skip dead monsters */
+        if (!mon->race) continue;
+
+        if (relevant) update_mon_aux(p, mon, c, false, &blos, &dis_to_closest, &closest, &lowhp);
+
+        /* Track closest player */
+        if (full) update_closest(p, mon, c);
+
+        /* Update the cursor */
+        source_monster(who, mon);
+        if (source_equal(&p->cursor_who, who)) p->upkeep->redraw |= (PR_CURSOR);
+    }
+}
+
+
 /*
  * Monster (and player) actual movement
  */
@@ -630,6 +761,7 @@ void monster_swap(struct chunk *c, struct loc *grid1, struct loc *grid2)
 
         /* Move monster */
         loc_copy(&mon->grid, &to);
+        mflag_off(mon->mflag, MFLAG_DORMANT);
 
         /* Update monster */
         update_mon(mon, c, true);
@@ -648,6 +780,7 @@ void monster_swap(struct chunk *c, struct loc *grid1, struct loc *grid2)
 
         /* Move player */
         loc_copy(&p->grid, &to);
+        wake_dormant_monsters(c, distance(&p->old_grid, &p->grid));
         player_leaving(p, c, &p->old_grid, &p->grid);
 
         /* Update the trap detection status */
@@ -675,6 +808,7 @@ void monster_swap(struct chunk *c, struct loc *grid1, struct loc *grid2)
 
         /* Move monster */
         loc_copy(&mon->grid, &from);
+        mflag_off(mon->mflag, MFLAG_DORMANT);
 
         /* Update monster */
         update_mon(mon, c, true);
@@ -693,6 +827,7 @@ void monster_swap(struct chunk *c, struct loc *grid1, struct loc *grid2)
 
         /* Move player */
         loc_copy(&p->grid, &from);
+        wake_dormant_monsters(c, distance(&p->old_grid, &p->grid));
         player_leaving(p, c, &p->old_grid, &p->grid);
 
         /* Update the trap detection status */
@@ -1821,6 +1956,47 @@ void update_players(void)
 }
 
 
+/*
+ * Updates the visibility flags between one player and everyone else, after that player moved
+ * or changed in a way that doesn't affect how other players see each other.
+ */
+void update_players_for(struct player *p)
+{
+    int i;
+    struct chunk *c = chunk_get(&p->wpos);
+    struct source who_body;
+    struct source *who = &who_body;
+    bool relevant = (!p->upkeep->new_level_method && !p->upkeep->funeral && p->placed && c);
+
+    /* Everyone seeing this player */
+    if (p->placed) update_player(p);
+
+    /* This player seeing everyone */
+    for (i = 1; i <= NumPlayers; i++)
+    {
+        struct player *q = player_get(i);
+
+        /* Make sure he's properly placed */
+        if ((q == p) || !q->placed) continue;
+
+        source_player(who, 0, q);
+
+        /* Irrelevant players: remove from view */
+        if (!relevant || !wpos_eq(&p->wpos, &q->wpos))
+        {
+            remove_player_from_view(p, q);
+            if (source_equal_player_or_monster(&p->upkeep->health_who, who))
+                p->upkeep->redraw |= (PR_HEALTH);
+        }
+        else
+            update_player_aux(p, q, c);
+
+        /* Update the cursor */
+        if (source_equal(&p->cursor_who, who)) p->upkeep->redraw |= (PR_CURSOR);
+    }
+}
+
+
 bool is_humanoid(const struct monster_race *race)
 {
     return rf_has(race->flags, RF_HUMANOID);
@@ -1836,6 +2012,9 @@ bool is_half_humanoid(const struct monster_race *race)
 }
 
 
+/*
+ * The state of a monster changed: only players that can see it need to update their list
+ */
 void update_monlist(struct monster *mon)
 {
     int i;
@@ -1844,7 +2023,7 @@ void update_monlist(struct monster *mon)
     {
         struct player *p = player_get(i);
 
-        if (wpos_eq(&p->wpos, &mon->wpos))
+        if (wpos_eq(&p->wpos, &mon->wpos) && monster_is_visible(p, mon->midx))
             p->upkeep->redraw |= PR_MONLIST;
     }
 }
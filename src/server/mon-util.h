@@ -26,6 +26,7 @@ extern void player_desc(struct player *p, char *desc, size_t max, struct player
     bool capitalize);
 extern void update_mon(struct monster *mon, struct chunk *c, bool full);
 extern void update_monsters(struct chunk *c, bool full);
+extern void update_monsters_for(struct player *p, struct chunk *c, bool full);
 extern bool monster_carry(struct monster *mon, struct object *obj, bool force);
 extern void monster_swap(struct chunk *c, struct loc *grid1, struct loc *grid2);
 extern void monster_wake(struct player *p, struct monster *mon, bool notify, int aware_chance);
@@ -42,6 +43,7 @@ extern void monster_take_terrain_damage(struct chunk *c, struct monster *mon);
 extern bool monster_taking_terrain_damage(struct chunk *c, struct monster *mon);
 extern void update_player(struct player *q);
 extern void update_players(void);
+extern void update_players_for(struct player *p);
 extern bool is_humanoid(const struct monster_race *race);
 extern bool is_half_humanoid(const struct monster_race *race);
 extern void update_monlist(struct monster *mon);
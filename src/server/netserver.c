@@ -2511,7 +2511,7 @@ static int rle_encode(sockbuf_t* buf, cave_view_type* lineref, int max_col, int
         n = 1;
 
         /* Count repetitions of this grid */
-        while (mode && (lineref[x1].c == c) && (lineref[x1].a == a) && (x1 < max_col))
+        while (mode && (x1 < max_col) && (lineref[x1].c == c) && (lineref[x1].a == a))
         {
             /* Increment count and column */
             n++;
@@ -2628,6 +2628,121 @@ static connection_t* get_mind_link(struct player *p)
  * the next byte contains the number of repetitions of the previous grid.
  */
 #define DUNGEON_RLE_MODE(P) ((P)->use_graphics? RLE_LARGE: RLE_CLASSIC)
+
+
+/*
+ * Map line deltas
+ *
+ * The server remembers what it last sent for each line of the main map (map_sent_scr and
+ * map_sent_trn). As long as the client holds that frame, only the spans of grids that changed
+ * since then are sent (PKT_LINE_DELTA) and unchanged lines are not sent at all.
+ *
+ * Since the stream is reliable and ordered, the client holds the last frame unless it says
+ * otherwise: a redraw request drops the baseline, as does anything else that overwrites the
+ * client map buffer (mini map or full map on the main screen, mind link) or a change of screen
+ * size. Remote terms (like the mini map subwindow) have their own buffers and keep it.
+ * The next frame is then sent as full lines ("keyframe"). A keyframe is also forced every
+ * MAP_KEYFRAME_FRAMES frames.
+ *
+ * Clients older than MAP_DELTA_VERSION don't know PKT_LINE_DELTA and always get full lines.
+ */
+#define MAP_KEYFRAME_FRAMES 100
+#define MAP_DELTA_GAP       3
+#define MAP_DELTA_SPANS     32
+#define MAP_DELTA_VERSION   0x1625
+
+
+/*
+ * Drop the map baseline of a player, so the next map redraw is sent as a keyframe
+ */
+void map_baseline_reset(struct player *p)
+{
+    p->map_sent_valid = false;
+}
+
+
+/*
+ * Check if the client of a player understands map deltas
+ */
+static bool map_deltas_supported(struct player *p)
+{
+    return (p->version >= MAP_DELTA_VERSION);
+}
+
+
+static bool map_grid_changed(struct player *p, int y, int x)
+{
+    if ((p->scr_info[y][x].c != p->map_sent_scr[y][x].c) ||
+        (p->scr_info[y][x].a != p->map_sent_scr[y][x].a))
+    {
+        return true;
+    }
+    if (!p->use_graphics) return false;
+    return ((p->trn_info[y][x].c != p->map_sent_trn[y][x].c) ||
+        (p->trn_info[y][x].a != p->map_sent_trn[y][x].a));
+}
+
+
+/*
+ * Send the spans of a map line that differ from the baseline
+ *
+ * Returns false if a full line would be cheaper, in which case nothing is sent.
+ */
+static bool send_line_delta(struct player *p, connection_t *connp, int y, int cols)
+{
+    int16_t span_x[MAP_DELTA_SPANS], span_len[MAP_DELTA_SPANS];
+    int x, n = 0, changed = 0, i;
+
+    /* Collect the spans, merging those separated by only a few unchanged grids */
+    for (x = 0; x < cols; x++)
+    {
+        if (!map_grid_changed(p, y, x)) continue;
+
+        if (n && (x - (span_x[n - 1] + span_len[n - 1]) < MAP_DELTA_GAP))
+        {
+            changed += x + 1 - (span_x[n - 1] + span_len[n - 1]);
+            span_len[n - 1] = x + 1 - span_x[n - 1];
+            continue;
+        }
+
+        /* Too fragmented */
+        if (n == MAP_DELTA_SPANS) return false;
+
+        span_x[n] = x;
+        span_len[n] = 1;
+        changed++;
+        n++;
+    }
+
+    /* Nothing changed */
+    if (!n)
+    {
+        prof_count(PROF_MAP_SKIPPED, 1);
+        return true;
+    }
+
+    /* Most of the line changed */
+    if (changed * 2 > cols) return false;
+
+    Packet_printf(&connp->c, "%b%hd%hd%b", (unsigned)PKT_LINE_DELTA, y, cols, (unsigned)n);
+    for (i = 0; i < n; i++)
+    {
+        Packet_printf(&connp->c, "%hd%hd", (int)span_x[i], (int)span_len[i]);
+        if (p->use_graphics)
+            rle_encode(&connp->c, p->trn_info[y] + span_x[i], span_len[i], RLE_LARGE);
+        rle_encode(&connp->c, p->scr_info[y] + span_x[i], span_len[i], DUNGEON_RLE_MODE(p));
+    }
+
+    prof_count(PROF_MAP_DELTA, 1);
+    return true;
+}
+
+
+/*
+ * Send a line of the main map
+ *
+ * When the client holds the previous frame, only changed grids are sent (see above).
+ */
 int Send_line_info(struct player *p, int y)
 {
     struct player *p_ptr2 = NULL;
@@ -2644,6 +2759,41 @@ int Send_line_info(struct player *p, int y)
     {
         p_ptr2 = find_player(p->esp_link);
         screen_wid2 = p_ptr2->screen_cols / p_ptr2->tile_wid;
+
+        /* The mind-linked client now displays our map */
+        map_baseline_reset(p_ptr2);
+    }
+
+    /* Only the main map of a single client that supports them can use deltas */
+    if (connp2 || (p->remote_term != NTERM_WIN_OVERHEAD) || (screen_wid != p->map_sent_cols) ||
+        !map_deltas_supported(p))
+    {
+        map_baseline_reset(p);
+    }
+
+    /* End of frame */
+    if (y == -1)
+    {
+        /* A full frame was just sent: use it as baseline */
+        if (!p->map_sent_valid)
+        {
+            p->map_sent_valid = (!connp2 && (p->remote_term == NTERM_WIN_OVERHEAD) &&
+                map_deltas_supported(p));
+            p->map_sent_cols = screen_wid;
+            p->map_sent_frames = 0;
+        }
+
+        /* Force a keyframe from time to time */
+        else if (++p->map_sent_frames >= MAP_KEYFRAME_FRAMES)
+            map_baseline_reset(p);
+    }
+
+    /* Send the changes only */
+    else if (p->map_sent_valid && send_line_delta(p, connp, y, screen_wid))
+    {
+        memcpy(p->map_sent_scr[y], p->scr_info[y], screen_wid * sizeof(cave_view_type));
+        memcpy(p->map_sent_trn[y], p->trn_info[y], screen_wid * sizeof(cave_view_type));
+        return 1;
     }
 
     /* Put a header on the packet */
@@ -2665,6 +2815,14 @@ int Send_line_info(struct player *p, int y)
     if (connp2)
         rle_encode(&connp2->c, p->scr_info[y], screen_wid2, DUNGEON_RLE_MODE(p_ptr2));
 
+    /* Remember what the client has */
+    memcpy(p->map_sent_scr[y], p->scr_info[y], screen_wid * sizeof(cave_view_type));
+    memcpy(p->map_sent_trn[y], p->trn_info[y], screen_wid * sizeof(cave_view_type));
+    prof_count(PROF_MAP_FULL, 1);
+
+    /* The whole line is up to date */
+    flag_wipe(p->map_dirty[y], FLAG_SIZE(z_info->dungeon_wid + COL_MAP));
+
     return 1;
 }
 
@@ -2747,6 +2905,9 @@ int Send_char(struct player *p, struct loc *grid, uint16_t a, char c, uint16_t t
     {
         struct player *p_ptr2 = find_player(p->esp_link);
 
+        /* The mind-linked client now displays our map */
+        map_baseline_reset(p_ptr2);
+
         if (p_ptr2->use_graphics && (p_ptr2->remote_term == NTERM_WIN_OVERHEAD))
         {
             Packet_printf(&connp2->c, "%b%b%b%hu%c%hu%c", (unsigned)PKT_CHAR, (unsigned)grid->x,
@@ -2759,6 +2920,18 @@ int Send_char(struct player *p, struct loc *grid, uint16_t a, char c, uint16_t t
         }
     }
 
+    /* Keep the map baseline in sync with the client */
+    if (p->remote_term == NTERM_WIN_OVERHEAD)
+    {
+        p->map_sent_scr[grid->y][grid->x].a = a;
+        p->map_sent_scr[grid->y][grid->x].c = c;
+        if (p->use_graphics)
+        {
+            p->map_sent_trn[grid->y][grid->x].a = ta;
+            p->map_sent_trn[grid->y][grid->x].c = tc;
+        }
+    }
+
     if (p->use_graphics && (p->remote_term == NTERM_WIN_OVERHEAD))
     {
         return Packet_printf(&connp->c, "%b%b%b%hu%c%hu%c", (unsigned)PKT_CHAR, (unsigned)grid->x,
@@ -2769,6 +2942,122 @@ int Send_char(struct player *p, struct loc *grid, uint16_t a, char c, uint16_t t
 }
 
 
+/*
+ * Batched map grids
+ *
+ * Grids of the main map that change during a frame are marked in a dirty bitmap instead of
+ * being sent one PKT_CHAR at a time. They are sent as runs of consecutive grids (PKT_CHARS)
+ * by Send_chars_flush(), which is called from Net_output_p() and before anything that needs
+ * them on screen (Send_flush(), remote term changes). The values are read from the map
+ * baseline, so a grid changed several times in a frame is only sent once.
+ *
+ * Mind links, remote terms and clients older than MAP_DELTA_VERSION still use PKT_CHAR.
+ */
+static void send_char_spans(struct player *p, connection_t *connp, uint8_t *span_x,
+    uint8_t *span_y, uint8_t *span_len, int n)
+{
+    int i;
+
+    Packet_printf(&connp->c, "%b%hd", (unsigned)PKT_CHARS, n);
+    for (i = 0; i < n; i++)
+    {
+        Packet_printf(&connp->c, "%b%b%b", (unsigned)span_x[i], (unsigned)span_y[i],
+            (unsigned)span_len[i]);
+        if (p->use_graphics)
+        {
+            rle_encode(&connp->c, p->map_sent_trn[span_y[i]] + span_x[i], span_len[i],
+                RLE_LARGE);
+        }
+        rle_encode(&connp->c, p->map_sent_scr[span_y[i]] + span_x[i], span_len[i],
+            DUNGEON_RLE_MODE(p));
+    }
+
+    prof_count(PROF_MAP_PACKETS, 1);
+}
+
+
+int Send_chars_flush(struct player *p)
+{
+    connection_t *connp;
+    uint8_t span_x[MAX_CHAR_SPANS], span_y[MAX_CHAR_SPANS], span_len[MAX_CHAR_SPANS];
+    size_t row_size = FLAG_SIZE(z_info->dungeon_wid + COL_MAP);
+    size_t rows_size = FLAG_SIZE(z_info->dungeon_hgt + ROW_MAP + 1);
+    int n = 0, y, x;
+
+    /* Nothing to send */
+    if (!p->map_dirty_rows || flag_is_empty(p->map_dirty_rows, rows_size)) return 1;
+
+    connp = get_connection(p->conn);
+    for (y = flag_next(p->map_dirty_rows, rows_size, FLAG_START); y != FLAG_END;
+        y = flag_next(p->map_dirty_rows, rows_size, y + 1))
+    {
+        bitflag *row = p->map_dirty[y - FLAG_START];
+
+        /* Collect the runs of dirty grids */
+        x = flag_next(row, row_size, FLAG_START);
+        while ((x != FLAG_END) && (connp->state == CONN_PLAYING))
+        {
+            int len = 1;
+
+            while ((len < 255) && (x + len < FLAG_MAX(row_size)) && flag_has(row, row_size, x + len))
+                len++;
+
+            span_x[n] = (uint8_t)(x - FLAG_START);
+            span_y[n] = (uint8_t)(y - FLAG_START);
+            span_len[n] = (uint8_t)len;
+            prof_count(PROF_MAP_GRIDS, len);
+
+            /* Packet is full */
+            if (++n == MAX_CHAR_SPANS)
+            {
+                send_char_spans(p, connp, span_x, span_y, span_len, n);
+                n = 0;
+            }
+
+            x = flag_next(row, row_size, x + len);
+        }
+
+        flag_wipe(row, row_size);
+    }
+    flag_wipe(p->map_dirty_rows, rows_size);
+
+    if (n && (connp->state == CONN_PLAYING)) send_char_spans(p, connp, span_x, span_y, span_len, n);
+
+    return 1;
+}
+
+
+/*
+ * Queue a grid of the main map to be sent at the end of the frame
+ */
+int Send_char_batched(struct player *p, struct loc *grid, uint16_t a, char c, uint16_t ta,
+    char tc)
+{
+    /* Paranoia */
+    if (!p) return 0;
+
+    /* Mind links, remote terms and old clients need PKT_CHAR */
+    if (get_mind_link(p) || (p->remote_term != NTERM_WIN_OVERHEAD) || !map_deltas_supported(p))
+    {
+        Send_chars_flush(p);
+        return Send_char(p, grid, a, c, ta, tc);
+    }
+
+    p->map_sent_scr[grid->y][grid->x].a = a;
+    p->map_sent_scr[grid->y][grid->x].c = c;
+    if (p->use_graphics)
+    {
+        p->map_sent_trn[grid->y][grid->x].a = ta;
+        p->map_sent_trn[grid->y][grid->x].c = tc;
+    }
+
+    flag_on(p->map_dirty[grid->y], FLAG_SIZE(z_info->dungeon_wid + COL_MAP), grid->x + FLAG_START);
+    flag_on(p->map_dirty_rows, FLAG_SIZE(z_info->dungeon_hgt + ROW_MAP + 1), grid->y + FLAG_START);
+
+    return 1;
+}
+
+
 int Send_spell_info(struct player *p, int book, int i, const char *out_val, spell_flags *flags,
     int smana)
 {
@@ -2883,6 +3172,9 @@ int Send_mini_map(struct player *p, int y, int16_t w)
     connection_t *connp = get_connp(p, "mini map");
     if (connp == NULL) return 0;
 
+    /* The mini map overwrites the client map buffer, unless it goes to its own window */
+    if (p->remote_term == NTERM_WIN_OVERHEAD) map_baseline_reset(p);
+
     /* Packet header */
     Packet_printf(&connp->c, "%b%hd%hd", (unsigned)PKT_MINI_MAP, y, (int)w);
 
@@ -3071,6 +3363,7 @@ int Send_term_info(struct player *p, int mode, uint16_t arg)
     if (mode == NTERM_ACTIVATE)
     {
         if (p->remote_term == (uint8_t)arg) return 1;
+        Send_chars_flush(p);
         p->remote_term = (uint8_t)arg;
     }
 
@@ -3343,6 +3636,9 @@ int Send_fullmap(struct player *p, int y)
     connection_t *connp = get_connp(p, "full map");
     if (connp == NULL) return 0;
 
+    /* The full map overwrites the client map buffer */
+    map_baseline_reset(p);
+
     /* Packet header */
     Packet_printf(&connp->c, "%b%hd", (unsigned)PKT_FULLMAP, y);
 
@@ -3431,6 +3727,9 @@ int Send_flush(struct player *p, bool fresh, char delay)
     connection_t *connp = get_connp(p, "flush");
     if (connp == NULL) return 0;
 
+    /* Grids must be displayed before the pause */
+    Send_chars_flush(p);
+
     /* Don't display animations if fire_till_kill is enabled */
     if (p->firing_request) delay = 0;
 
@@ -5171,6 +5470,9 @@ static int Receive_redraw(int ind)
         /* Break mind link */
         break_mind_link(p);
 
+        /* The client lost its map: send a keyframe */
+        map_baseline_reset(p);
+
         do_cmd_redraw(p);
     }
 
@@ -6579,8 +6881,8 @@ static bool Limit_connections(int ind)
         }
 
         /* Skip DM */
-        if (!my_stricmp(connp->nick, cfg_dungeon_master)) continue;
-        if (!my_stricmp(p->name, cfg_dungeon_master)) continue;
+        if (cfg_dungeon_master && !my_stricmp(connp->nick, cfg_dungeon_master)) continue;
+        if (cfg_dungeon_master && !my_stricmp(p->name, cfg_dungeon_master)) continue;
 
         /* Only one connection allowed? */
         if (!cfg_limit_player_connections) continue;
@@ -6945,19 +7247,35 @@ static int sync_settings(struct player *p)
 
         verify_panel(p);
 
-        /* Redraw map */
+        /* Redraw map (in full: the client cleared its screen) */
+        map_baseline_reset(p);
         p->upkeep->redraw |= (PR_MAP);
     }
 
+    /* The client may redraw its map differently: don't send deltas against the old frame */
+    if ((p->use_graphics != connp->Client_setup.settings[SETTING_USE_GRAPHICS]) ||
+        (p->tile_wid != connp->Client_setup.settings[SETTING_TILE_WID]) ||
+        (p->tile_hgt != connp->Client_setup.settings[SETTING_TILE_HGT]))
+    {
+        map_baseline_reset(p);
+    }
+
     /* Process "settings" */
     p->use_graphics = connp->Client_setup.settings[SETTING_USE_GRAPHICS];
     p->tile_wid = connp->Client_setup.settings[SETTING_TILE_WID];
     p->tile_hgt = connp->Client_setup.settings[SETTING_TILE_HGT];
     p->tile_distorted = connp->Client_setup.settings[SETTING_TILE_DISTORTED];
     p->max_hgt = connp->Client_setup.settings[SETTING_MAX_HGT];
-    p->window_flag = connp->Client_setup.settings[SETTING_WINDOW_FLAG];
     p->opts.hitpoint_warn = connp->Client_setup.settings[SETTING_HITPOINT_WARN];
 
+    /* Subwindows may have been moved around: send the lists again */
+    if (p->window_flag != (uint32_t)connp->Client_setup.settings[SETTING_WINDOW_FLAG])
+    {
+        p->window_flag = connp->Client_setup.settings[SETTING_WINDOW_FLAG];
+        monster_list_invalidate(p);
+        object_list_invalidate(p);
+    }
+
     return 1;
 }
 
@@ -7020,6 +7338,9 @@ static int Receive_options(int ind)
         for (i = 0; i < OPT_MAX; i++)
             p->opts.opt[i] = connp->options[i];
 
+        /* Item descriptions depend on some options (show_flavors...) */
+        item_cache_invalidate(p);
+
         /* Update birth options */
         update_birth_options(p, &options, true);
 
@@ -7749,6 +8070,9 @@ static int Receive_ignore(int ind)
             if (new_ignore_level[i] > p->opts.ignore_lvl[i]) ignore = true;
             p->opts.ignore_lvl[i] = new_ignore_level[i];
         }
+
+        /* Ignore settings show in item descriptions */
+        item_cache_invalidate(p);
     }
 
     /* Notice and redraw as needed */
@@ -8127,6 +8451,9 @@ int Net_output_p(struct player *p)
 {
     connection_t *connp = get_connection(p->conn);
 
+    /* Send the grids that changed during this frame */
+    Send_chars_flush(p);
+
     /*
      * If we have any data to send to the client, terminate it
      * and send it to the client.
@@ -136,6 +136,7 @@ extern int Send_status(struct player *p, int16_t *effects);
 extern int Send_recall(struct player *p, int16_t word_recall, int16_t deep_descent);
 extern int Send_state(struct player *p, bool stealthy, bool resting, bool unignoring,
     const char *terrain);
+extern void map_baseline_reset(struct player *p);
 extern int Send_line_info(struct player *p, int y);
 extern int Send_remote_line(struct player *p, int y);
 extern int Send_speed(struct player *p, int speed, int mult);
@@ -143,6 +144,9 @@ extern int Send_study(struct player *p, int study, bool can_study_book);
 extern int Send_count(struct player *p, uint8_t type, int16_t count);
 extern int Send_show_floor(struct player *p, uint8_t mode);
 extern int Send_char(struct player *p, struct loc *grid, uint16_t a, char c, uint16_t ta, char tc);
+extern int Send_chars_flush(struct player *p);
+extern int Send_char_batched(struct player *p, struct loc *grid, uint16_t a, char c, uint16_t ta,
+    char tc);
 extern int Send_spell_info(struct player *p, int book, int i, const char *out_val,
     spell_flags *flags, int smana);
 extern int Send_book_info(struct player *p, int book, const char *name);
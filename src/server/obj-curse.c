@@ -69,8 +69,7 @@ void copy_curses(struct object *obj, int *source)
 
     if (!source) return;
 
-    if (!obj->curses)
-        obj->curses = mem_zalloc(z_info->curse_max * sizeof(struct curse_data));
+    if (!obj->curses) obj->curses = object_curses_new();
 
     for (i = 0; i < z_info->curse_max; i++)
     {
@@ -146,8 +145,7 @@ static void check_object_curses(struct object *obj)
     }
 
     /* Free the curse structure */
-    mem_free(obj->curses);
-    obj->curses = NULL;
+    object_curses_free(obj);
 }
 
 
@@ -197,8 +195,7 @@ static bool append_object_curse(struct object *obj, int pick, int power)
     struct curse *c = &curses[pick];
     int i;
 
-    if (!obj->curses)
-        obj->curses = mem_zalloc(z_info->curse_max * sizeof(struct curse_data));
+    if (!obj->curses) obj->curses = object_curses_new();
 
     /* Reject conflicting curses */
     for (i = 0; i < z_info->curse_max; i++)
@@ -320,8 +317,7 @@ void remove_object_curse(struct player *p, struct object *obj, int index, bool m
         if (obj->curses[i].power) return;
     }
 
-    mem_free(obj->curses);
-    obj->curses = NULL;
+    object_curses_free(obj);
 }
 
 
@@ -499,8 +495,7 @@ bool do_curse_effect(struct player *p, int i)
 
 bool append_curse(struct object *obj, struct object *source, int i)
 {
-    if (!obj->curses)
-        obj->curses = mem_zalloc(z_info->curse_max * sizeof(struct curse_data));
+    if (!obj->curses) obj->curses = object_curses_new();
 
     /* Check for existence */
     if (obj->curses[i].power)
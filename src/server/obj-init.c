@@ -1545,8 +1545,11 @@ static void cleanup_curse(void)
         string_free(curses[i].name);
         string_free(curses[i].conflict);
         string_free(curses[i].desc);
-        if (curses[i].obj) free_effect(curses[i].obj->effect);
-        mem_free(curses[i].obj);
+        if (curses[i].obj)
+        {
+            free_effect(curses[i].obj->effect);
+            object_free(curses[i].obj);
+        }
         mem_free(curses[i].poss);
     }
     mem_free(curses);
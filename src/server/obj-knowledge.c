@@ -894,6 +894,7 @@ void object_sense(struct player *p, struct object *obj)
     loc_copy(&new_obj->grid, &obj->grid);
     memcpy(&new_obj->wpos, &obj->wpos, sizeof(struct worldpos));
     pile_insert_end(&square_p(p, &new_obj->grid)->obj, new_obj);
+    square_list_pile(p, &new_obj->grid);
 }
 
 
@@ -1003,11 +1004,7 @@ void player_know_object(struct player *p, struct object *obj)
             else if (obj->known->curses)
                 obj->known->curses[i].power = 0;
         }
-        if (!known_cursed && obj->known->curses)
-        {
-            mem_free(obj->known->curses);
-            obj->known->curses = NULL;
-        }
+        if (!known_cursed && obj->known->curses) object_curses_free(obj->known);
     }
 
     /* Set ego type if known */
@@ -1102,6 +1099,7 @@ void update_player_object_knowledge(struct player *p)
     /* Housekeeping */
     p->upkeep->update |= (PU_BONUS | PU_INVEN);
     p->upkeep->notice |= (PN_COMBINE);
+    item_cache_invalidate(p);
     set_redraw_equip(p, NULL);
     set_redraw_inven(p, NULL);
     if (c) redraw_floor(&p->wpos, &p->grid, NULL);
@@ -1975,6 +1973,7 @@ static void object_flavor_aware_aux(struct player *p, struct object *obj, bool s
     /* Fully aware of the effects */
     p->kind_aware[obj->kind->kidx] = true;
     if (send) Send_aware(p, obj->kind->kidx);
+    item_cache_invalidate(p);
     apply_autoinscription(p, obj);
 
     /* A bunch of things are now known */
@@ -2033,7 +2032,9 @@ void object_flavor_tried(struct player *p, struct object *obj)
     /* Paranoia: don't mark artifacts as tried */
     if (obj->artifact) return;
 
+    if (p->kind_tried[obj->kind->kidx]) return;
     p->kind_tried[obj->kind->kidx] = true;
+    item_cache_invalidate(p);
 }
 
 
@@ -2339,14 +2340,11 @@ void object_know_brands_and_slays(struct object *obj)
 void object_know_curses(struct object *obj)
 {
     /* Wipe all previous known and know everything */
-    mem_free(obj->known->curses);
-    obj->known->curses = NULL;
+    object_curses_free(obj->known);
     if (obj->curses)
     {
-        size_t array_size = z_info->curse_max * sizeof(struct curse_data);
-
-        obj->known->curses = mem_zalloc(array_size);
-        memcpy(obj->known->curses, obj->curses, array_size);
+        obj->known->curses = object_curses_new();
+        memcpy(obj->known->curses, obj->curses, z_info->curse_max * sizeof(struct curse_data));
     }
 }
 
@@ -324,12 +324,14 @@ static void object_list_format_textblock(struct player *p, const object_list_t *
  *
  * height is the height of the list.
  * width is the width of the list.
+ *
+ * Returns true if the list changed since it was last sent to the subwindow.
  */
-void object_list_show_subwindow(struct player *p, int height, int width)
+bool object_list_show_subwindow(struct player *p, int height, int width)
 {
 	object_list_t *list;
 
-    if ((height < 1) || (width < 1)) return;
+    if ((height < 1) || (width < 1)) return false;
 
     list = object_list_shared_instance(p);
 
@@ -348,6 +350,9 @@ void object_list_show_subwindow(struct player *p, int height, int width)
 
     /* Restore height and width of current dungeon level */
     text_out_done(p);
+
+    /* Nothing to send if the list looks the same */
+    return text_out_changed(p, &list->sent, height, width);
 }
 
 
@@ -6,7 +6,7 @@
 #ifndef OBJECT_LIST_UI_H
 #define OBJECT_LIST_UI_H
 
-extern void object_list_show_subwindow(struct player *p, int height, int width);
+extern bool object_list_show_subwindow(struct player *p, int height, int width);
 extern void object_list_show_interactive(struct player *p, int height, int width);
 
 #endif /* OBJECT_LIST_UI_H */
@@ -53,6 +53,7 @@ void object_list_free(object_list_t *list)
 {
 	if (list == NULL) return;
 	if (list->entries != NULL) mem_free(list->entries);
+    text_out_copy_free(&list->sent);
 	mem_free(list);
 }
 
@@ -88,6 +89,17 @@ object_list_t *object_list_shared_instance(struct player *p)
 }
 
 
+/*
+ * Force the next subwindow update to be sent, even if the list didn't change.
+ */
+void object_list_invalidate(struct player *p)
+{
+    object_list_t *list = (object_list_t *)p->object_list_subwindow;
+
+    if (list) text_out_copy_free(&list->sent);
+}
+
+
 /*
  * Return true if there is nothing preventing the list from being updated. This
  * should be for structural sanity checks and not gameplay checks.
@@ -105,9 +117,15 @@ static bool object_list_can_update(object_list_t *list)
  */
 void object_list_reset(object_list_t *list)
 {
+	int i;
+
 	if ((list == NULL) || (list->entries == NULL)) return;
 
-	memset(list->entries, 0, list->entries_size * sizeof(object_list_entry_t));
+	/* Entries are filled in order, so only the first ones need to be cleared */
+	for (i = 0; (i < (int)list->entries_size) && list->entries[i].object; i++)
+	{
+		memset(&list->entries[i], 0, sizeof(object_list_entry_t));
+	}
 	memset(list->total_entries, 0, OBJECT_LIST_SECTION_MAX * sizeof(uint16_t));
 	memset(list->total_objects, 0, OBJECT_LIST_SECTION_MAX * sizeof(uint16_t));
     list->distinct_entries = 0;
@@ -132,84 +150,125 @@ static bool object_list_should_ignore_object(struct player *p, struct chunk *c,
 }
 
 
+/*
+ * Collect object information from a grid of the current cave.
+ *
+ * Returns false if the list is full.
+ */
+static bool object_list_collect_grid(struct player *p, struct chunk *c, object_list_t *list,
+    struct loc *grid)
+{
+    object_list_entry_t *entry;
+    int entry_index;
+    int field;
+    bool los = false;
+    struct object *obj;
+
+    obj = square_known_pile(p, c, grid);
+
+    /* Skip unfilled entries, unknown objects and monster-held objects */
+    if (!obj) return true;
+
+    /* Determine which section of the list the object entry is in */
+    los = (projectable(p, c, &p->grid, grid, PROJECT_NONE, true) || loc_eq(grid, &p->grid));
+    field = (los? OBJECT_LIST_SECTION_LOS: OBJECT_LIST_SECTION_NO_LOS);
+
+    for ( ; obj; obj = obj->next)
+    {
+        if (object_list_should_ignore_object(p, c, obj)) continue;
+
+        /* Find or add a list entry. */
+        entry = NULL;
+        for (entry_index = 0; entry_index < (int)list->entries_size; entry_index++)
+        {
+            int j;
+
+            /* We found an empty slot, so add this object here. */
+            if (list->entries[entry_index].object == NULL)
+            {
+                list->entries[entry_index].object = obj;
+                for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
+                    list->entries[entry_index].count[j] = 0;
+                list->entries[entry_index].dy = grid->y - p->grid.y;
+                list->entries[entry_index].dx = grid->x - p->grid.x;
+                list->entries[entry_index].player = p;
+                entry = &list->entries[entry_index];
+                break;
+            }
+
+            /* Use a matching object if we find one. */
+            if (!is_unknown(obj) &&
+                object_mergeable(p, obj, list->entries[entry_index].object, OSTACK_LIST))
+            {
+                /* We found a matching object and we'll use that. */
+                entry = &list->entries[entry_index];
+                break;
+            }
+        }
+
+        if (entry == NULL) return false;
+
+        /* We only know the number of objects we've actually seen */
+        if (!is_unknown(obj))
+            entry->count[field] += obj->number;
+        else
+            entry->count[field] = 1;
+    }
+
+    return true;
+}
+
+
 /*
  * Collect object information from the current cave.
+ *
+ * Only the grids in the list of known piles are scanned. Grids whose pile has been forgotten
+ * are dropped from that list on the way.
  */
 void object_list_collect(struct player *p, object_list_t *list)
 {
 	int i;
     struct chunk *c = chunk_get(&p->wpos);
-    struct loc begin, end;
-    struct loc_iterator iter;
+    struct player_cave *cave = p->cave;
 
 	if (!object_list_can_update(list)) return;
 
-    loc_init(&begin, 1, 1);
-    loc_init(&end, c->width, c->height);
-    loc_iterator_first(&iter, &begin, &end);
-
-	/* Scan each object in the dungeon. */
-    do
+    /* DM has full knowledge: scan each object in the dungeon */
+    if (p->dm_flags & DM_SEE_LEVEL)
     {
-        object_list_entry_t *entry;
-        int entry_index;
-        int field;
-        bool los = false;
-        struct object *obj;
-
-        obj = square_known_pile(p, c, &iter.cur);
+        struct loc begin, end;
+        struct loc_iterator iter;
 
-        /* Skip unfilled entries, unknown objects and monster-held objects */
-        if (!obj) continue;
+        loc_init(&begin, 1, 1);
+        loc_init(&end, c->width, c->height);
+        loc_iterator_first(&iter, &begin, &end);
 
-        /* Determine which section of the list the object entry is in */
-        los = (projectable(p, c, &p->grid, &iter.cur, PROJECT_NONE, true) ||
-            loc_eq(&iter.cur, &p->grid));
-        field = (los? OBJECT_LIST_SECTION_LOS: OBJECT_LIST_SECTION_NO_LOS);
+        do
+        {
+            if (!object_list_collect_grid(p, c, list, &iter.cur)) return;
+        }
+        while (loc_iterator_next_strict(&iter));
+    }
 
-        for ( ; obj; obj = obj->next)
+    /* Scan each known pile */
+    else
+    {
+        i = 0;
+        while (i < cave->num_piles)
         {
-            if (object_list_should_ignore_object(p, c, obj)) continue;
+            struct loc *grid = &cave->piles[i];
 
-            /* Find or add a list entry. */
-            entry = NULL;
-            for (entry_index = 0; entry_index < (int)list->entries_size; entry_index++)
+            if (!square_p(p, grid)->obj)
             {
-                int j;
-
-                /* We found an empty slot, so add this object here. */
-                if (list->entries[entry_index].object == NULL)
-                {
-                    list->entries[entry_index].object = obj;
-                    for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
-                        list->entries[entry_index].count[j] = 0;
-                    list->entries[entry_index].dy = iter.cur.y - p->grid.y;
-                    list->entries[entry_index].dx = iter.cur.x - p->grid.x;
-                    list->entries[entry_index].player = p;
-                    entry = &list->entries[entry_index];
-                    break;
-                }
-
-                /* Use a matching object if we find one. */
-                if (!is_unknown(obj) &&
-                    object_mergeable(p, obj, list->entries[entry_index].object, OSTACK_LIST))
-                {
-                    /* We found a matching object and we'll use that. */
-                    entry = &list->entries[entry_index];
-                    break;
-                }
+                square_p(p, grid)->listed = false;
+                loc_copy(grid, &cave->piles[--cave->num_piles]);
+                continue;
             }
 
-            if (entry == NULL) return;
-
-            /* We only know the number of objects we've actually seen */
-            if (!is_unknown(obj))
-                entry->count[field] += obj->number;
-            else
-                entry->count[field] = 1;
+            if (!object_list_collect_grid(p, c, list, grid)) return;
+            i++;
         }
     }
-    while (loc_iterator_next_strict(&iter));
 
 	/* Collect totals for easier calculations of the list. */
 	for (i = 0; i < (int)list->entries_size; i++)
@@ -23,6 +23,8 @@ typedef struct object_list_entry_s
     struct player *player;
 } object_list_entry_t;
 
+struct text_out_copy;
+
 typedef struct object_list_s
 {
 	object_list_entry_t *entries;
@@ -31,6 +33,7 @@ typedef struct object_list_s
 	uint16_t total_entries[OBJECT_LIST_SECTION_MAX];
 	uint16_t total_objects[OBJECT_LIST_SECTION_MAX];
 	bool sorted;
+    struct text_out_copy *sent; /* List last sent to the subwindow (NULL to force an update) */
 } object_list_t;
 
 extern object_list_t *object_list_new(void);
@@ -38,6 +41,7 @@ extern void object_list_free(object_list_t *list);
 extern void object_list_init(struct player *p);
 extern void object_list_finalize(struct player *p);
 extern object_list_t *object_list_shared_instance(struct player *p);
+extern void object_list_invalidate(struct player *p);
 extern void object_list_reset(object_list_t *list);
 extern void object_list_collect(struct player *p, object_list_t *list);
 extern int object_list_standard_compare(const void *a, const void *b);
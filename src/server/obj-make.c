@@ -27,13 +27,34 @@
 uint16_t level_golds[128];
 
 
-/** Arrays holding an index of objects to generate for a given level */
-static uint32_t *obj_total;
-static uint8_t *obj_alloc;
+/*
+ * Object kinds that can be generated, sorted by tval
+ */
+static int16_t *obj_kinds;
+static int obj_kinds_num;
+static int16_t obj_tval_start[TV_MAX];
+static int16_t obj_tval_num[TV_MAX];
+
+
+/*
+ * Alias tables of the object kinds to generate for a given level (see Rand_alias_init())
+ *
+ * Entries follow obj_kinds[]. The tval tables use the same arrays, each tval covering its own
+ * range of entries (with aliases relative to the start of the range).
+ */
+struct obj_alloc
+{
+    uint32_t total;                 /* Total probability */
+    uint32_t *cut;
+    int16_t *alias;
+    uint32_t tval_total[TV_MAX];    /* Total probability of each tval */
+    uint32_t *tval_cut;
+    int16_t *tval_alias;
+};
 
 
-static uint32_t *obj_total_great;
-static uint8_t *obj_alloc_great;
+/* Tables for each level, normal then "good" */
+static struct obj_alloc *obj_alloc;
 
 
 static int16_t alloc_ego_size = 0;
@@ -67,40 +88,67 @@ static uint8_t get_artifact_rarity(int32_t value, struct object_kind *kind)
  */
 static void alloc_init_objects(void)
 {
-    int item, lev;
+    int item, lev, tval;
     int k_max = z_info->k_max;
     int i;
 
+    /* List the object kinds that have a rarity, sorted by tval */
+    obj_kinds = mem_zalloc(k_max * sizeof(int16_t));
+    obj_kinds_num = 0;
+    for (tval = 0; tval < TV_MAX; tval++)
+    {
+        obj_tval_start[tval] = (int16_t)obj_kinds_num;
+        for (item = 0; item < k_max; item++)
+        {
+            const struct object_kind *kind = &k_info[item];
+
+            if (kind->alloc_prob && (kind->tval == tval)) obj_kinds[obj_kinds_num++] = (int16_t)item;
+        }
+        obj_tval_num[tval] = (int16_t)(obj_kinds_num - obj_tval_start[tval]);
+    }
+
     /* Allocate and wipe */
-    obj_alloc = mem_zalloc((z_info->max_obj_depth + 1) * k_max * sizeof(uint8_t));
-    obj_alloc_great = mem_zalloc((z_info->max_obj_depth + 1) * k_max * sizeof(uint8_t));
-    obj_total = mem_zalloc(z_info->max_depth * sizeof(uint32_t));
-    obj_total_great = mem_zalloc(z_info->max_depth * sizeof(uint32_t));
+    obj_alloc = mem_zalloc((z_info->max_obj_depth + 1) * 2 * sizeof(struct obj_alloc));
 
-    /* Init allocation data */
-    for (item = 0; item < k_max; item++)
+    /* Go through all the dungeon levels, normal then "good" */
+    for (lev = 0; lev <= z_info->max_obj_depth; lev++)
     {
-        const struct object_kind *kind = &k_info[item];
-        int min = kind->alloc_min;
-        int max = kind->alloc_max;
+        for (i = 0; i < 2; i++)
+        {
+            struct obj_alloc *alloc = &obj_alloc[lev * 2 + i];
 
-        /* If an item doesn't have a rarity, move on */
-        if (!kind->alloc_prob) continue;
+            alloc->cut = mem_zalloc(obj_kinds_num * sizeof(uint32_t));
+            alloc->alias = mem_zalloc(obj_kinds_num * sizeof(int16_t));
+            alloc->tval_cut = mem_zalloc(obj_kinds_num * sizeof(uint32_t));
+            alloc->tval_alias = mem_zalloc(obj_kinds_num * sizeof(int16_t));
 
-        /* Go through all the dungeon levels */
-        for (lev = 0; lev <= z_info->max_obj_depth; lev++)
-        {
-            int rarity = kind->alloc_prob;
+            /* Init allocation data */
+            for (item = 0; item < obj_kinds_num; item++)
+            {
+                const struct object_kind *kind = &k_info[obj_kinds[item]];
+                uint32_t rarity = kind->alloc_prob;
 
-            /* Save the probability in the standard table */
-            if ((lev < min) || (lev > max)) rarity = 0;
-            obj_total[lev] += rarity;
-            obj_alloc[(lev * k_max) + item] = rarity;
+                /* Save the probability in the standard table */
+                if ((lev < kind->alloc_min) || (lev > kind->alloc_max)) rarity = 0;
+
+                /* Save the probability in the "great" table if relevant */
+                if (i && !kind_is_good(kind)) rarity = 0;
+
+                alloc->cut[item] = rarity;
+                alloc->total += rarity;
+                alloc->tval_cut[item] = rarity;
+                alloc->tval_total[kind->tval] += rarity;
+            }
 
-            /* Save the probability in the "great" table if relevant */
-            if (!kind_is_good(kind)) rarity = 0;
-            obj_total_great[lev] += rarity;
-            obj_alloc_great[(lev * k_max) + item] = rarity;
+            /* Build the alias tables */
+            Rand_alias_init(alloc->cut, alloc->alias, obj_kinds_num, alloc->total);
+            for (tval = 0; tval < TV_MAX; tval++)
+            {
+                int start = obj_tval_start[tval];
+
+                Rand_alias_init(alloc->tval_cut + start, alloc->tval_alias + start,
+                    obj_tval_num[tval], alloc->tval_total[tval]);
+            }
         }
     }
 
@@ -243,14 +291,20 @@ static void cleanup_obj_make(void)
     money_type = NULL;
     mem_free(alloc_ego_table);
     alloc_ego_table = NULL;
-    mem_free(obj_total_great);
-    obj_total_great = NULL;
-    mem_free(obj_total);
-    obj_total = NULL;
-    mem_free(obj_alloc_great);
-    obj_alloc_great = NULL;
+    if (obj_alloc)
+    {
+        for (i = 0; i < (z_info->max_obj_depth + 1) * 2; i++)
+        {
+            mem_free(obj_alloc[i].cut);
+            mem_free(obj_alloc[i].alias);
+            mem_free(obj_alloc[i].tval_cut);
+            mem_free(obj_alloc[i].tval_alias);
+        }
+    }
     mem_free(obj_alloc);
     obj_alloc = NULL;
+    mem_free(obj_kinds);
+    obj_kinds = NULL;
 }
 
 
@@ -1574,37 +1628,19 @@ bool kind_is_good(const struct object_kind *kind)
  */
 static struct object_kind *get_obj_num_by_kind(int level, bool good, int tval)
 {
-    size_t ind, item;
-    uint32_t value;
-    int total = 0;
-    uint8_t *objects = (good? obj_alloc_great: obj_alloc);
-
-    /* This is the base index into obj_alloc for this dlev */
-    ind = level * z_info->k_max;
-
-    /* Get new total */
-    for (item = 0; item < (size_t)z_info->k_max; item++)
-    {
-        if (k_info[item].tval == tval) total += objects[ind + item];
-    }
+    struct obj_alloc *alloc = &obj_alloc[level * 2 + (good? 1: 0)];
+    int start, item;
 
     /* No appropriate items of that tval */
-    if (!total) return NULL;
-
-    value = randint0(total);
+    if ((tval < 0) || (tval >= TV_MAX) || !alloc->tval_total[tval]) return NULL;
 
     /* Pick an object */
-    for (item = 0; item < (size_t)z_info->k_max; item++)
-    {
-        if (k_info[item].tval == tval)
-        {
-            if (value < (uint32_t)objects[ind + item]) break;
-            value -= objects[ind + item];
-        }
-    }
+    start = obj_tval_start[tval];
+    item = Rand_alias(alloc->tval_cut + start, alloc->tval_alias + start, obj_tval_num[tval],
+        alloc->tval_total[tval]);
 
     /* Return the item index */
-    return &k_info[item];
+    return &k_info[obj_kinds[start + item]];
 }
 
 
@@ -1615,8 +1651,8 @@ static struct object_kind *get_obj_num_by_kind(int level, bool good, int tval)
  */
 struct object_kind *get_obj_num(int level, bool good, int tval)
 {
-    size_t ind, item;
-    uint32_t value;
+    struct obj_alloc *alloc;
+    int item;
 
     /* Occasional level boost */
     if ((level > 0) && one_in_(z_info->great_obj))
@@ -1631,40 +1667,16 @@ struct object_kind *get_obj_num(int level, bool good, int tval)
 
     if (tval) return get_obj_num_by_kind(level, good, tval);
 
-    /* This is the base index into obj_alloc for this dlev */
-    ind = level * z_info->k_max;
-
-    /* Pick an object */
-    if (!good)
-    {
-        value = randint0(obj_total[level]);
-        for (item = 0; item < (size_t)z_info->k_max; item++)
-        {
-            /* Found it */
-            if (value < (uint32_t)obj_alloc[ind + item]) break;
-
-            /* Decrement */
-            value -= obj_alloc[ind + item];
-        }
-    }
-    else
-    {
-        value = randint0(obj_total_great[level]);
-        for (item = 0; item < (size_t)z_info->k_max; item++)
-        {
-            /* Found it */
-            if (value < (uint32_t)obj_alloc_great[ind + item]) break;
-
-            /* Decrement */
-            value -= obj_alloc_great[ind + item];
-        }
-    }
+    alloc = &obj_alloc[level * 2 + (good? 1: 0)];
 
     /* Paranoia */
-    if (item == (size_t)z_info->k_max) return NULL;
+    if (!alloc->total) return NULL;
+
+    /* Pick an object */
+    item = Rand_alias(alloc->cut, alloc->alias, obj_kinds_num, alloc->total);
 
     /* Return the item index */
-    return &k_info[item];
+    return &k_info[obj_kinds[item]];
 }
 
 
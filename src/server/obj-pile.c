@@ -21,6 +21,17 @@
 #include "s-angband.h"
 
 
+/*
+ * Pools for objects and their curses
+ */
+#define OBJECTS_PER_SLAB    256
+#define CURSES_PER_SLAB     32
+
+
+static struct mem_pool *object_pool;
+static struct mem_pool *curse_pool;
+
+
 struct pile_integrity_info
 {
     struct object *fail_pile;
@@ -254,7 +265,54 @@ bool pile_contains(const struct object *top, const struct object *obj)
  */
 struct object *object_new(void)
 {
-    return mem_zalloc(sizeof(struct object));
+    if (!object_pool) object_pool = mem_pool_new(sizeof(struct object), OBJECTS_PER_SLAB);
+
+    return mem_pool_zalloc(object_pool);
+}
+
+
+/*
+ * Create a new (empty) array of curses for an object
+ */
+struct curse_data *object_curses_new(void)
+{
+    if (!curse_pool)
+        curse_pool = mem_pool_new(z_info->curse_max * sizeof(struct curse_data), CURSES_PER_SLAB);
+
+    return mem_pool_zalloc(curse_pool);
+}
+
+
+/*
+ * Free the curses of an object
+ */
+void object_curses_free(struct object *obj)
+{
+    mem_pool_free(curse_pool, obj->curses);
+    obj->curses = NULL;
+}
+
+
+/*
+ * Get the allocation counters of the object and curse pools
+ */
+void object_pool_counters(struct mem_counters *obj_counters,
+    struct mem_counters *curse_counters)
+{
+    mem_pool_counters(object_pool, obj_counters);
+    mem_pool_counters(curse_pool, curse_counters);
+}
+
+
+/*
+ * Free the object and curse pools (all objects must have been freed)
+ */
+void free_object_pools(void)
+{
+    mem_pool_destroy(object_pool);
+    object_pool = NULL;
+    mem_pool_destroy(curse_pool);
+    curse_pool = NULL;
 }
 
 
@@ -267,9 +325,18 @@ void object_free(struct object *obj)
 {
     mem_free(obj->slays);
     mem_free(obj->brands);
-    mem_free(obj->curses);
+    object_curses_free(obj);
+
+    mem_pool_free(object_pool, obj);
+}
+
 
-    mem_free(obj);
+/*
+ * Free a shallow copy of an object (made with memcpy), leaving its pointers alone
+ */
+void object_free_shallow(struct object *obj)
+{
+    mem_pool_free(object_pool, obj);
 }
 
 
@@ -773,10 +840,8 @@ void object_copy(struct object *dest, const struct object *src)
     }
     if (src->curses)
     {
-        size_t array_size = z_info->curse_max * sizeof(struct curse_data);
-
-        dest->curses = mem_zalloc(array_size);
-        memcpy(dest->curses, src->curses, array_size);
+        dest->curses = object_curses_new();
+        memcpy(dest->curses, src->curses, z_info->curse_max * sizeof(struct curse_data));
     }
 
     /* Detach from any pile */
@@ -936,6 +1001,50 @@ static int grid_to_index(struct chunk *c, struct loc *grid, struct object *obj)
 }
 
 
+/*
+ * Floor objects with timeouts
+ *
+ * Rods and corpses on the floor are kept in a per-chunk list, so process_objects() only needs
+ * to look at them instead of scanning the whole level. Objects enter the list when they get a
+ * floor index and leave it when the index is released.
+ */
+void floor_timed_add(struct chunk *c, struct object *obj)
+{
+    int fidx = 0 - (obj->oidx + 1);
+
+    if (obj->oidx >= 0) return;
+    if (!tval_can_have_timeout(obj) && !tval_is_corpse(obj)) return;
+
+    if (!c->timed_pos) c->timed_pos = mem_zalloc(MAX_OBJECTS * sizeof(uint16_t));
+    if (c->timed_pos[fidx]) return;
+
+    if (c->timed_num == c->timed_alloc)
+    {
+        c->timed_alloc = (c->timed_alloc? c->timed_alloc * 2: 16);
+        c->timed_obj = mem_realloc(c->timed_obj, c->timed_alloc * sizeof(struct object *));
+    }
+    c->timed_obj[c->timed_num++] = obj;
+    c->timed_pos[fidx] = c->timed_num;
+}
+
+
+void floor_timed_remove(struct chunk *c, struct object *obj)
+{
+    int fidx = 0 - (obj->oidx + 1), pos;
+    struct object *last;
+
+    if ((obj->oidx >= 0) || !c->timed_pos || !c->timed_pos[fidx]) return;
+
+    /* Move the last object in the hole */
+    pos = c->timed_pos[fidx] - 1;
+    c->timed_pos[fidx] = 0;
+    last = c->timed_obj[--c->timed_num];
+    if (last == obj) return;
+    c->timed_obj[pos] = last;
+    c->timed_pos[0 - (last->oidx + 1)] = pos + 1;
+}
+
+
 /*
  * Obtain an index for a floor object
  */
@@ -1062,6 +1171,7 @@ bool floor_carry(struct player *p, struct chunk *c, struct loc *grid, struct obj
 
     /* Link to the first object in the pile */
     pile_insert(&square(c, grid)->obj, drop);
+    floor_timed_add(c, drop);
 
     /* Redraw */
     square_note_spot(c, grid);
@@ -1099,6 +1209,7 @@ bool floor_add(struct chunk *c, struct loc *grid, struct object *drop)
 
     /* Link to the last object in the pile */
     pile_insert_end(&square(c, grid)->obj, drop);
+    floor_timed_add(c, drop);
 
     /* Result */
     return true;
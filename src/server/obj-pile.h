@@ -38,7 +38,13 @@ extern void pile_excise(struct object **pile, struct object *obj);
 extern struct object *pile_last_item(struct object *pile);
 extern bool pile_contains(const struct object *top, const struct object *obj);
 extern struct object *object_new(void);
+extern struct curse_data *object_curses_new(void);
+extern void object_curses_free(struct object *obj);
+extern void object_pool_counters(struct mem_counters *obj_counters,
+    struct mem_counters *curse_counters);
+extern void free_object_pools(void);
 extern void object_free(struct object *obj);
+extern void object_free_shallow(struct object *obj);
 extern void object_delete(struct object **obj_address);
 extern void object_pile_free(struct object *obj);
 extern bool object_similar(struct player *p, const struct object *obj1, const struct object *obj2,
@@ -60,6 +66,8 @@ extern struct object *floor_object_for_use(struct player *p, struct chunk *c,
 extern bool floor_carry(struct player *p, struct chunk *c, struct loc *grid, struct object *drop,
     bool *note);
 extern bool floor_add(struct chunk *c, struct loc *grid, struct object *drop);
+extern void floor_timed_add(struct chunk *c, struct object *obj);
+extern void floor_timed_remove(struct chunk *c, struct object *obj);
 extern void drop_near(struct player *p, struct chunk *c, struct object **dropped, int chance,
     struct loc *grid, bool verbose, int mode, bool prefer_pile);
 extern void push_object(struct player *p, struct chunk *c, struct loc *grid);
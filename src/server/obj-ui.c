@@ -65,7 +65,125 @@ char object_char(struct player *p, const struct object *obj)
 }
 
 
-void display_item(struct player *p, struct object *obj, uint8_t equipped)
+/*
+ * Cached item descriptions
+ *
+ * Describing an item is expensive (three calls to object_desc() and get_object_info()), so the
+ * last description sent for each item index is remembered. A cached description is reused as
+ * long as the object is the same, the hash of the fields its description depends on didn't
+ * change and the player's change stamp wasn't bumped. The stamp is bumped when something that
+ * affects all descriptions changes (object knowledge, flavor awareness, ignore settings, player
+ * state). An item whose description didn't change is not sent again, unless the client list
+ * was cleared in the meantime.
+ */
+
+
+/*
+ * Mark all cached item descriptions as outdated
+ */
+void item_cache_invalidate(struct player *p)
+{
+    p->upkeep->item_stamp++;
+}
+
+
+/*
+ * Free the cached item descriptions
+ */
+void item_cache_free(struct player *p)
+{
+    mem_free(p->upkeep->item_cache);
+    p->upkeep->item_cache = NULL;
+    p->upkeep->item_cache_size = 0;
+}
+
+
+/*
+ * Return the cached description for an item index, or NULL if the index can't be cached
+ */
+static struct item_cache *item_cache_entry(struct player *p, const struct object *obj)
+{
+    int size = z_info->pack_size + p->body.count + z_info->quiver_size;
+
+    if ((obj->oidx < 0) || (obj->oidx >= size)) return NULL;
+
+    if (p->upkeep->item_cache_size < size)
+    {
+        item_cache_free(p);
+        p->upkeep->item_cache = mem_zalloc(size * sizeof(struct item_cache));
+        p->upkeep->item_cache_size = size;
+    }
+
+    return &p->upkeep->item_cache[obj->oidx];
+}
+
+
+static uint32_t item_key_add(uint32_t key, uint32_t value)
+{
+    return (key ^ value) * 16777619U;
+}
+
+
+static uint32_t item_key_add_object(uint32_t key, const struct object *obj)
+{
+    size_t i;
+
+    /* Known objects may use placeholder pointers: hash the pointers, never dereference them */
+    key = item_key_add(key, (uint32_t)(uintptr_t)obj->kind);
+    key = item_key_add(key, (uint32_t)(uintptr_t)obj->ego);
+    key = item_key_add(key, (uint32_t)(uintptr_t)obj->artifact);
+    key = item_key_add(key, (uint32_t)obj->pval);
+    key = item_key_add(key, (uint32_t)obj->weight);
+    key = item_key_add(key, ((uint32_t)obj->dd << 8) | obj->ds);
+    key = item_key_add(key, (uint32_t)obj->ac);
+    key = item_key_add(key, (uint32_t)obj->to_a);
+    key = item_key_add(key, (uint32_t)obj->to_h);
+    key = item_key_add(key, (uint32_t)obj->to_d);
+    for (i = 0; i < OF_SIZE; i++) key = item_key_add(key, obj->flags[i]);
+    for (i = 0; i < OBJ_MOD_MAX; i++) key = item_key_add(key, (uint32_t)obj->modifiers[i]);
+    for (i = 0; i < ELEM_MAX; i++) key = item_key_add(key, (uint32_t)obj->el_info[i].res_level[0]);
+    if (obj->curses)
+    {
+        for (i = 0; i < (size_t)z_info->curse_max; i++)
+            key = item_key_add(key, (uint32_t)obj->curses[i].power);
+    }
+    key = item_key_add(key, (uint32_t)(uintptr_t)obj->effect);
+    key = item_key_add(key, (uint32_t)obj->timeout);
+    key = item_key_add(key, obj->number);
+    key = item_key_add(key, obj->notice);
+
+    return key;
+}
+
+
+/*
+ * Hash the fields of an item that its description depends on
+ */
+static uint32_t item_key(struct player *p, const struct object *obj, uint8_t equipped)
+{
+    uint32_t key = 2166136261U;
+    int i;
+
+    /* The item */
+    key = item_key_add_object(key, obj);
+    key = item_key_add_object(key, obj->known);
+    key = item_key_add(key, (uint32_t)obj->note);
+    key = item_key_add(key, obj->ignore_protect);
+    key = item_key_add(key, (uint32_t)obj->oidx);
+    key = item_key_add(key, equipped);
+    key = item_key_add(key, (object_is_in_quiver(p, obj)? 1: 0));
+
+    /* Prices and slots depend on the store and the equipment */
+    key = item_key_add(key, (uint32_t)p->store_num);
+    for (i = 0; i < p->body.count; i++)
+        key = item_key_add(key, (p->body.slots[i].obj? p->body.slots[i].obj->kind->kidx + 1: 0));
+
+    return key;
+}
+
+
+static void describe_item(struct player *p, struct object *obj, uint8_t equipped, int *wgt_out,
+    int32_t *price_out, struct object_xtra *info_xtra_out)
 {
     struct object_xtra info_xtra;
     char o_name[NORMAL_WID];
@@ -109,8 +227,123 @@ void display_item(struct player *p, struct object *obj, uint8_t equipped)
     my_strcpy(info_xtra.name_terse, o_name_terse, sizeof(info_xtra.name_terse));
     my_strcpy(info_xtra.name_base, o_name_base, sizeof(info_xtra.name_base));
 
-    /* Send the info to the client */
+    *wgt_out = wgt;
+    *price_out = price;
+    memcpy(info_xtra_out, &info_xtra, sizeof(info_xtra));
+}
+
+
+/*
+ * Send an item to the client
+ *
+ * If "cached" is true, the cached description is used when the item didn't change. Otherwise
+ * the item is described again, but still not sent if its description didn't change.
+ */
+static void display_item_aux(struct player *p, struct object *obj, uint8_t equipped, bool cached)
+{
+    struct item_cache *entry = item_cache_entry(p, obj);
+    struct object_xtra info_xtra;
+    int wgt;
+    int32_t price;
+    uint32_t key;
+
+    /* Not cached */
+    if (!entry)
+    {
+        describe_item(p, obj, equipped, &wgt, &price, &info_xtra);
+        Send_item(p, obj, wgt, price, &info_xtra);
+        return;
+    }
+
+    key = item_key(p, obj, equipped);
+
+    /* Nothing changed */
+    if (cached && (entry->obj == obj) && (entry->stamp == p->upkeep->item_stamp) &&
+        (entry->key == key))
+    {
+        if (!entry->sent) Send_item(p, obj, entry->wgt, entry->price, &entry->info_xtra);
+        entry->sent = true;
+        return;
+    }
+
+    describe_item(p, obj, equipped, &wgt, &price, &info_xtra);
+
+    /* Send the info to the client if the description changed */
+    if (!entry->sent || (entry->key != key) || (entry->wgt != wgt) || (entry->price != price) ||
+        memcmp(&entry->info_xtra, &info_xtra, sizeof(info_xtra)))
+    {
+        Send_item(p, obj, wgt, price, &info_xtra);
+    }
+
+    /* Remember the description */
+    entry->obj = obj;
+    entry->stamp = p->upkeep->item_stamp;
+    entry->key = key;
+    entry->sent = true;
+    entry->wgt = wgt;
+    entry->price = price;
+    memcpy(&entry->info_xtra, &info_xtra, sizeof(info_xtra));
+}
+
+
+void display_item(struct player *p, struct object *obj, uint8_t equipped)
+{
+    display_item_aux(p, obj, equipped, false);
+}
+
+
+/*
+ * Clear the inventory (equipped = 0) or the equipment (equipped = 1) on the client, unless
+ * it already holds the current items
+ */
+static void clear_items(struct player *p, uint8_t equipped)
+{
+    struct object *obj;
+    struct object_xtra info_xtra;
+    int wgt, i, listed = 0, sent = 0;
+    int32_t price;
+
+    /* Check that every item was sent at its current index */
+    for (obj = p->gear; obj; obj = obj->next)
+    {
+        struct item_cache *entry;
+
+        if (object_is_equipped(p->body, obj) != (bool)equipped) continue;
+
+        entry = item_cache_entry(p, obj);
+        if (!entry || !entry->sent || (entry->obj != obj) ||
+            (entry->info_xtra.equipped != equipped))
+        {
+            listed = -1;
+            break;
+        }
+        listed++;
+    }
+
+    /* Check that nothing else was sent */
+    for (i = 0; i < p->upkeep->item_cache_size; i++)
+    {
+        struct item_cache *entry = &p->upkeep->item_cache[i];
+
+        if (entry->sent && (entry->info_xtra.equipped == equipped)) sent++;
+    }
+
+    if (listed == sent) return;
+
+    /* Forget the items sent so far */
+    for (i = 0; i < p->upkeep->item_cache_size; i++)
+    {
+        struct item_cache *entry = &p->upkeep->item_cache[i];
+
+        if (entry->info_xtra.equipped == equipped) entry->sent = false;
+    }
+
+    /* Clear */
+    obj = object_new();
+    object_prep(p, chunk_get(&p->wpos), obj, pile_kind, 0, MINIMISE);
+    describe_item(p, obj, equipped, &wgt, &price, &info_xtra);
     Send_item(p, obj, wgt, price, &info_xtra);
+    object_delete(&obj);
 }
 
 
@@ -159,10 +392,7 @@ void display_inven(struct player *p)
     int i;
 
     /* Clear */
-    obj = object_new();
-    object_prep(p, chunk_get(&p->wpos), obj, pile_kind, 0, MINIMISE);
-    display_item(p, obj, 0);
-    object_delete(&obj);
+    clear_items(p, 0);
 
     /* Display the pack */
     for (obj = p->gear; obj; obj = obj->next)
@@ -171,7 +401,7 @@ void display_inven(struct player *p)
         if (object_is_equipped(p->body, obj)) continue;
 
         /* Send the info to the client */
-        display_item(p, obj, 0);
+        display_item_aux(p, obj, 0, true);
     }
 
     /* Wait for creation */
@@ -233,10 +463,7 @@ void display_equip(struct player *p)
     int i;
 
     /* Clear */
-    obj = object_new();
-    object_prep(p, chunk_get(&p->wpos), obj, pile_kind, 0, MINIMISE);
-    display_item(p, obj, 1);
-    object_delete(&obj);
+    clear_items(p, 1);
 
     /* Display the equipment */
     for (obj = p->gear; obj; obj = obj->next)
@@ -245,7 +472,7 @@ void display_equip(struct player *p)
         if (!object_is_equipped(p->body, obj)) continue;
 
         /* Send the info to the client */
-        display_item(p, obj, 1);
+        display_item_aux(p, obj, 1, true);
     }
 
     /* Wait for creation */
@@ -6,10 +6,26 @@
 #ifndef OBJECT_UI_H
 #define OBJECT_UI_H
 
+/*
+ * Cached description of an item (see display_item())
+ */
+struct item_cache
+{
+    const struct object *obj;       /* Object described */
+    uint32_t stamp;                 /* Change stamp of the player when described */
+    uint32_t key;                   /* Hash of the object fields the description depends on */
+    bool sent;                      /* Description sent since the client list was cleared */
+    int wgt;
+    int32_t price;
+    struct object_xtra info_xtra;
+};
+
 extern uint8_t object_kind_attr(struct player *p, const struct object_kind *kind);
 extern char object_kind_char(struct player *p, const struct object_kind *kind);
 extern uint8_t object_attr(struct player *p, const struct object *obj);
 extern char object_char(struct player *p, const struct object *obj);
+extern void item_cache_invalidate(struct player *p);
+extern void item_cache_free(struct player *p);
 extern void display_item(struct player *p, struct object *obj, uint8_t equipped);
 extern void set_redraw_inven(struct player *p, struct object *obj);
 extern void display_inven(struct player *p);
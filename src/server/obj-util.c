@@ -968,8 +968,6 @@ void shimmer_objects(struct player *p, struct chunk *c)
 void process_objects(struct chunk *c)
 {
     int i;
-    struct loc begin, end;
-    struct loc_iterator iter;
 
     /* Every 10 game turns */
     if ((turn.turn % 10) != 5) return;
@@ -988,46 +986,35 @@ void process_objects(struct chunk *c)
         shimmer_objects(p, c);
     }
 
-    loc_init(&begin, 1, 1);
-    loc_init(&end, c->width, c->height);
-    loc_iterator_first(&iter, &begin, &end);
-
-    /* Recharge other level objects */
-    do
+    /* Recharge other level objects (backwards, since deleted objects are replaced by the last) */
+    for (i = c->timed_num - 1; i >= 0; i--)
     {
-        struct object *obj, *next;
+        struct object *obj = c->timed_obj[i];
+        struct loc grid;
         bool redraw = false;
 
-        obj = square_object(c, &iter.cur);
+        loc_copy(&grid, &obj->grid);
 
-        while (obj)
+        /* Recharge rods */
+        if (tval_can_have_timeout(obj) && recharge_timeout(obj))
+            redraw = true;
+
+        /* Corpses slowly decompose */
+        if (tval_is_corpse(obj))
         {
-            next = obj->next;
+            obj->decay--;
 
-            /* Recharge rods */
-            if (tval_can_have_timeout(obj) && recharge_timeout(obj))
+            /* Notice changes */
+            if (obj->decay == obj->timeout / 5)
                 redraw = true;
 
-            /* Corpses slowly decompose */
-            if (tval_is_corpse(obj))
-            {
-                obj->decay--;
-
-                /* Notice changes */
-                if (obj->decay == obj->timeout / 5)
-                    redraw = true;
-
-                /* No more corpse... */
-                else if (!obj->decay)
-                    square_delete_object(c, &iter.cur, obj, false, false);
-            }
-
-            obj = next;
+            /* No more corpse... */
+            else if (!obj->decay)
+                square_delete_object(c, &grid, obj, false, false);
         }
 
-        if (redraw) redraw_floor(&c->wpos, &iter.cur, NULL);
+        if (redraw) redraw_floor(&c->wpos, &grid, NULL);
     }
-    while (loc_iterator_next_strict(&iter));
 }
 
 
@@ -1299,6 +1299,7 @@ static void player_setup(struct player *p, int id, uint32_t account, bool no_rec
 
     /* Add the player */
     square_set_mon(c, &p->grid, 0 - id);
+    wake_dormant_monsters(c, -1);
 
     /* Initialize bubble speed */
     p->bubble_speed = NORMAL_TIME;
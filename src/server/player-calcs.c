@@ -2662,6 +2662,13 @@ static void update_bonuses(struct player *p)
     if (weight_limit(&p->state) != weight_limit(&state))
         set_redraw_inven(p, NULL);
 
+    /* Item descriptions depend on skills, speed, blows... */
+    if (memcmp(&p->state, &state, sizeof(state)) ||
+        memcmp(&p->known_state, &known_state, sizeof(known_state)))
+    {
+        item_cache_invalidate(p);
+    }
+
     /* Wait for creation */
     if (!p->alive)
     {
@@ -2932,15 +2939,15 @@ void update_stuff(struct player *p, struct chunk *c)
     {
         p->upkeep->update &= ~(PU_DISTANCE);
         p->upkeep->update &= ~(PU_MONSTERS);
-        update_monsters(c, true);
-        update_players();
+        update_monsters_for(p, c, true);
+        update_players_for(p);
     }
 
     if (p->upkeep->update & PU_MONSTERS)
     {
         p->upkeep->update &= ~(PU_MONSTERS);
-        update_monsters(c, false);
-        update_players();
+        update_monsters_for(p, c, false);
+        update_players_for(p);
     }
 }
 
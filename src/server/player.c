@@ -487,16 +487,19 @@ void player_cave_new(struct player *p, int height, int width)
     p->cave->width = width;
 
     p->cave->squares = mem_zalloc(p->cave->height * sizeof(struct player_square*));
+    p->cave->arena = mem_arena_new(height * width * SQUARE_SIZE * sizeof(bitflag));
     p->cave->noise.grids = mem_zalloc(p->cave->height * sizeof(uint16_t*));
     p->cave->scent.grids = mem_zalloc(p->cave->height * sizeof(uint16_t*));
     for (grid.y = 0; grid.y < p->cave->height; grid.y++)
     {
         p->cave->squares[grid.y] = mem_zalloc(p->cave->width * sizeof(struct player_square));
         for (grid.x = 0; grid.x < p->cave->width; grid.x++)
-            square_p(p, &grid)->info = mem_zalloc(SQUARE_SIZE * sizeof(bitflag));
+            square_p(p, &grid)->info = mem_arena_zalloc(p->cave->arena,
+                SQUARE_SIZE * sizeof(bitflag));
         p->cave->noise.grids[grid.y] = mem_zalloc(p->cave->width * sizeof(uint16_t));
         p->cave->scent.grids[grid.y] = mem_zalloc(p->cave->width * sizeof(uint16_t));
     }
+    p->cave->num_piles = 0;
     p->cave->allocated = true;
 }
 
@@ -525,6 +528,20 @@ void init_player(struct player *p, int conn, bool old_history, bool no_recall)
         p->scr_info[i] = mem_zalloc((z_info->dungeon_wid + COL_MAP) * sizeof(cave_view_type));
         p->trn_info[i] = mem_zalloc((z_info->dungeon_wid + COL_MAP) * sizeof(cave_view_type));
     }
+    p->map_sent_scr = mem_zalloc((z_info->dungeon_hgt + ROW_MAP + 1) * sizeof(cave_view_type*));
+    p->map_sent_trn = mem_zalloc((z_info->dungeon_hgt + ROW_MAP + 1) * sizeof(cave_view_type*));
+    for (i = 0; i < z_info->dungeon_hgt + ROW_MAP + 1; i++)
+    {
+        p->map_sent_scr[i] = mem_zalloc((z_info->dungeon_wid + COL_MAP) * sizeof(cave_view_type));
+        p->map_sent_trn[i] = mem_zalloc((z_info->dungeon_wid + COL_MAP) * sizeof(cave_view_type));
+    }
+    p->map_dirty = mem_zalloc((z_info->dungeon_hgt + ROW_MAP + 1) * sizeof(bitflag*));
+    for (i = 0; i < z_info->dungeon_hgt + ROW_MAP + 1; i++)
+        p->map_dirty[i] = mem_zalloc(FLAG_SIZE(z_info->dungeon_wid + COL_MAP) * sizeof(bitflag));
+    p->map_dirty_rows = mem_zalloc(FLAG_SIZE(z_info->dungeon_hgt + ROW_MAP + 1) * sizeof(bitflag));
+    p->glyph_cache = mem_zalloc(z_info->dungeon_hgt * sizeof(struct glyph_cache*));
+    for (i = 0; i < z_info->dungeon_hgt; i++)
+        p->glyph_cache[i] = mem_zalloc(z_info->dungeon_wid * sizeof(struct glyph_cache));
 
     /* Allocate player sub-structs */
     p->upkeep = mem_zalloc(sizeof(struct player_upkeep));
@@ -534,7 +551,7 @@ void init_player(struct player *p, int conn, bool old_history, bool no_recall)
     p->obj_k = object_new();
     p->obj_k->brands = mem_zalloc(z_info->brand_max * sizeof(bool));
     p->obj_k->slays = mem_zalloc(z_info->slay_max * sizeof(bool));
-    p->obj_k->curses = mem_zalloc(z_info->curse_max * sizeof(struct curse_data));
+    p->obj_k->curses = object_curses_new();
 
     /* Allocate memory for lore array */
     p->lore = mem_zalloc(z_info->r_max * sizeof(struct monster_lore));
@@ -676,6 +693,7 @@ void cleanup_player(struct player *p)
     {
         mem_free(p->upkeep->inven);
         mem_free(p->upkeep->quiver);
+        item_cache_free(p);
     }
     mem_free(p->upkeep);
     p->upkeep = NULL;
@@ -699,6 +717,25 @@ void cleanup_player(struct player *p)
     p->scr_info = NULL;
     mem_free(p->trn_info);
     p->trn_info = NULL;
+    for (i = 0; p->map_sent_scr && (i < z_info->dungeon_hgt + ROW_MAP + 1); i++)
+    {
+        mem_free(p->map_sent_scr[i]);
+        mem_free(p->map_sent_trn[i]);
+    }
+    mem_free(p->map_sent_scr);
+    p->map_sent_scr = NULL;
+    mem_free(p->map_sent_trn);
+    p->map_sent_trn = NULL;
+    for (i = 0; p->map_dirty && (i < z_info->dungeon_hgt + ROW_MAP + 1); i++)
+        mem_free(p->map_dirty[i]);
+    mem_free(p->map_dirty);
+    p->map_dirty = NULL;
+    mem_free(p->map_dirty_rows);
+    p->map_dirty_rows = NULL;
+    for (i = 0; p->glyph_cache && (i < z_info->dungeon_hgt); i++)
+        mem_free(p->glyph_cache[i]);
+    mem_free(p->glyph_cache);
+    p->glyph_cache = NULL;
     for (i = 0; i < N_HISTORY_FLAGS; i++)
     {
         mem_free(p->hist_flags[i]);
@@ -800,7 +837,6 @@ void player_cave_free(struct player *p)
     {
         for (grid.x = 0; grid.x < p->cave->width; grid.x++)
         {
-            mem_free(square_p(p, &grid)->info);
             square_p(p, &grid)->info = NULL;
             square_forget_pile(p, &grid);
             square_forget_trap(p, &grid);
@@ -811,10 +847,16 @@ void player_cave_free(struct player *p)
     }
     mem_free(p->cave->squares);
     p->cave->squares = NULL;
+    mem_arena_free(p->cave->arena);
+    p->cave->arena = NULL;
     mem_free(p->cave->noise.grids);
     p->cave->noise.grids = NULL;
     mem_free(p->cave->scent.grids);
     p->cave->scent.grids = NULL;
+    mem_free(p->cave->piles);
+    p->cave->piles = NULL;
+    p->cave->num_piles = 0;
+    p->cave->max_piles = 0;
     p->cave->allocated = false;
 }
 
@@ -845,6 +887,7 @@ void player_cave_clear(struct player *p, bool full)
 
         /* Erase object */
         square_forget_pile(p, &iter.cur);
+        square_p(p, &iter.cur)->listed = false;
 
         /* Erase trap */
         square_forget_trap(p, &iter.cur);
@@ -868,6 +911,7 @@ void player_cave_clear(struct player *p, bool full)
         }
     }
     while (loc_iterator_next_strict(&iter));
+    p->cave->num_piles = 0;
 
     /* Memorize the content of owned houses */
     memorize_houses(p);
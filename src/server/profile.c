@@ -0,0 +1,377 @@
+/*
+ * File: profile.c
+ * Purpose: Per-phase frame profiler
+ *
+ * Copyright (c) 2026 MAngband and PWMAngband Developers
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+
+#include "s-angband.h"
+
+
+/*
+ * The main phases of run_game_loop() are timed with a monotonic clock. The time spent in each
+ * phase is summed over the frame, then added at the end of the frame to a log2 histogram of
+ * the current window. The last PROF_WINDOWS windows of PROF_WINDOW_SECS seconds are kept, so
+ * the console always shows the last minute or so of activity. Phases can nest (update_view()
+ * is mostly called while processing players or generating levels), so their times don't add
+ * up to the frame time.
+ */
+
+
+/* Number of histogram buckets: bucket b holds times in [2^(b-1), 2^b) microseconds */
+#define PROF_BUCKETS    20
+
+/* Rolling window */
+#define PROF_WINDOWS        6
+#define PROF_WINDOW_SECS    10
+
+
+struct prof_hist
+{
+    uint32_t active;                /* Frames where the phase ran */
+    uint32_t calls;                 /* Number of calls */
+    uint64_t usecs;                 /* Total time */
+    uint32_t max;                   /* Longest time per frame */
+    uint32_t bucket[PROF_BUCKETS];  /* Time per frame */
+};
+
+
+struct prof_slot
+{
+    uint32_t frames;                        /* Frames recorded */
+    uint32_t overruns;                      /* Frames over budget */
+    struct prof_hist hist[PROF_MAX + 1];    /* Phases, then whole frames */
+};
+
+
+static struct prof_slot slots[PROF_WINDOWS];
+static int cur_slot;
+
+/* Current frame */
+static bool in_frame;
+static uint64_t frame_start;
+static uint64_t frame_usecs[PROF_MAX];
+static uint32_t frame_calls[PROF_MAX];
+
+/* Totals since startup (or the last reset) */
+static uint64_t total_usecs[PROF_MAX + 1];
+static uint32_t total_calls[PROF_MAX + 1];
+static uint32_t total_overruns;
+
+/* Scheduler */
+static bool overloaded;
+static bool frame_late;
+static uint32_t total_late;
+static uint32_t total_caught_up;
+static uint32_t total_dropped;
+static uint32_t total_shed;
+
+/* Event counters */
+static uint32_t counters[PROF_COUNTER_MAX];
+static uint64_t counters_start;     /* When the counters started (0 until the first frame) */
+
+static const char *prof_names[PROF_MAX + 1] =
+{
+    "Net_input",
+    "monsters (pre)",
+    "players",
+    "monsters (post)",
+    "process_world",
+    "refresh_stuff",
+    "Net_output",
+    "generate_level",
+    "save",
+    "update_view",
+    "project",
+    "frame"
+};
+
+
+/*
+ * Return a monotonic timestamp, in microseconds
+ */
+uint64_t prof_clock(void)
+{
+#ifdef WINDOWS
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+
+    if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&now);
+
+    return (uint64_t)(now.QuadPart / freq.QuadPart) * 1000000 +
+        (uint64_t)(now.QuadPart % freq.QuadPart) * 1000000 / freq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
+}
+
+
+/*
+ * Add the time elapsed since "start" to a phase of the current frame
+ */
+void prof_account(int phase, uint64_t start)
+{
+    frame_usecs[phase] += prof_clock() - start;
+    frame_calls[phase]++;
+}
+
+
+/*
+ * Start timing a frame
+ *
+ * Anything accounted between two frames (server startup, console commands...) is discarded.
+ */
+void prof_begin_frame(void)
+{
+    memset(frame_usecs, 0, sizeof(frame_usecs));
+    memset(frame_calls, 0, sizeof(frame_calls));
+    in_frame = true;
+    frame_start = prof_clock();
+    if (!counters_start) counters_start = frame_start;
+}
+
+
+static void hist_add(struct prof_hist *hist, uint64_t usecs, uint32_t calls)
+{
+    uint32_t value = (uint32_t)MIN(usecs, 0xFFFFFFFF);
+    int b = 0;
+
+    while ((b < PROF_BUCKETS - 1) && (value >> b)) b++;
+
+    hist->active++;
+    hist->calls += calls;
+    hist->usecs += usecs;
+    if (value > hist->max) hist->max = value;
+    hist->bucket[b]++;
+}
+
+
+/*
+ * Stop timing a frame and add it to the current window
+ */
+void prof_end_frame(void)
+{
+    struct prof_slot *slot = &slots[cur_slot];
+    uint64_t usecs;
+    int i;
+
+    if (!in_frame) return;
+    in_frame = false;
+    usecs = prof_clock() - frame_start;
+
+    for (i = 0; i < PROF_MAX; i++)
+    {
+        if (!frame_calls[i]) continue;
+        hist_add(&slot->hist[i], frame_usecs[i], frame_calls[i]);
+        total_usecs[i] += frame_usecs[i];
+        total_calls[i] += frame_calls[i];
+    }
+    hist_add(&slot->hist[PROF_MAX], usecs, 1);
+    total_usecs[PROF_MAX] += usecs;
+    total_calls[PROF_MAX]++;
+
+    /* The frame took longer than 1/FPS seconds */
+    overloaded = frame_late;
+    frame_late = false;
+    if (usecs > (uint64_t)(1000000 / cfg_fps))
+    {
+        slot->overruns++;
+        total_overruns++;
+        overloaded = true;
+    }
+
+    /* Move to the next window, dropping the oldest one */
+    if (++slot->frames >= (uint32_t)(cfg_fps * PROF_WINDOW_SECS))
+    {
+        cur_slot = (cur_slot + 1) % PROF_WINDOWS;
+        memset(&slots[cur_slot], 0, sizeof(struct prof_slot));
+    }
+}
+
+
+const char *prof_name(int phase)
+{
+    return prof_names[phase];
+}
+
+
+/*
+ * Return the length of the rolling window, in seconds
+ */
+int prof_window_secs(void)
+{
+    return PROF_WINDOWS * PROF_WINDOW_SECS;
+}
+
+
+/*
+ * Upper bound of the bucket holding the given fraction of the samples
+ */
+static uint32_t hist_percentile(const uint32_t *bucket, uint32_t count, uint32_t max, int pct)
+{
+    uint32_t rank = (uint32_t)(((uint64_t)count * pct + 99) / 100), seen = 0;
+    int b;
+
+    for (b = 0; b < PROF_BUCKETS - 1; b++)
+    {
+        seen += bucket[b];
+        if (seen >= rank) return MIN((uint32_t)1 << b, max);
+    }
+
+    return max;
+}
+
+
+/*
+ * Get the statistics of a phase over the rolling window (phase = PROF_MAX for whole frames)
+ */
+void prof_window(int phase, struct prof_stats *stats)
+{
+    uint32_t bucket[PROF_BUCKETS];
+    int i, b;
+
+    memset(stats, 0, sizeof(struct prof_stats));
+    memset(bucket, 0, sizeof(bucket));
+
+    for (i = 0; i < PROF_WINDOWS; i++)
+    {
+        struct prof_hist *hist = &slots[i].hist[phase];
+
+        stats->frames += slots[i].frames;
+        stats->overruns += slots[i].overruns;
+        stats->active += hist->active;
+        stats->calls += hist->calls;
+        stats->usecs += hist->usecs;
+        if (hist->max > stats->max) stats->max = hist->max;
+        for (b = 0; b < PROF_BUCKETS; b++) bucket[b] += hist->bucket[b];
+    }
+
+    if (phase != PROF_MAX) stats->overruns = 0;
+    if (!stats->active) return;
+
+    stats->p50 = hist_percentile(bucket, stats->active, stats->max, 50);
+    stats->p99 = hist_percentile(bucket, stats->active, stats->max, 99);
+}
+
+
+/*
+ * Get the totals of a phase since startup (phase = PROF_MAX for whole frames)
+ */
+void prof_totals(int phase, uint64_t *usecs, uint32_t *calls, uint32_t *overruns)
+{
+    *usecs = total_usecs[phase];
+    *calls = total_calls[phase];
+    *overruns = ((phase == PROF_MAX)? total_overruns: 0);
+}
+
+
+/*
+ * Clear all statistics
+ */
+void prof_reset(void)
+{
+    memset(slots, 0, sizeof(slots));
+    cur_slot = 0;
+    memset(total_usecs, 0, sizeof(total_usecs));
+    memset(total_calls, 0, sizeof(total_calls));
+    total_overruns = 0;
+    total_late = 0;
+    total_caught_up = 0;
+    total_dropped = 0;
+    total_shed = 0;
+    memset(counters, 0, sizeof(counters));
+    counters_start = prof_clock();
+}
+
+
+/*
+ * Return true if the server can't keep up: the last frame went over budget or the scheduler
+ * found that frames were late
+ */
+bool prof_overloaded(void)
+{
+    return (overloaded || frame_late);
+}
+
+
+/*
+ * The scheduler is late: it ran "caught_up" extra frames and dropped "dropped" frames
+ */
+void prof_late(uint32_t caught_up, uint32_t dropped)
+{
+    frame_late = true;
+    total_late++;
+    total_caught_up += caught_up;
+    total_dropped += dropped;
+}
+
+
+/*
+ * Some work was deferred to the next frame because the server is overloaded
+ */
+void prof_shed(void)
+{
+    total_shed++;
+}
+
+
+/*
+ * Get the scheduler totals since startup
+ */
+void prof_sched_totals(uint32_t *late, uint32_t *caught_up, uint32_t *dropped, uint32_t *shed)
+{
+    *late = total_late;
+    *caught_up = total_caught_up;
+    *dropped = total_dropped;
+    *shed = total_shed;
+}
+
+
+/*
+ * Add to an event counter
+ */
+void prof_count(int counter, uint32_t n)
+{
+    counters[counter] += n;
+}
+
+
+/*
+ * Get an event counter since startup (or the last reset)
+ */
+uint32_t prof_counter(int counter)
+{
+    return counters[counter];
+}
+
+
+/*
+ * Get the average rate of an event counter since startup (or the last reset), per second
+ */
+double prof_counter_rate(int counter)
+{
+    uint64_t usecs;
+
+    if (!counters_start) return 0.0;
+    usecs = prof_clock() - counters_start;
+    if (!usecs) return 0.0;
+
+    return (double)counters[counter] * 1000000 / usecs;
+}
@@ -0,0 +1,82 @@
+/*
+ * File: profile.h
+ * Purpose: Per-phase frame profiler
+ */
+
+#ifndef INCLUDED_PROFILE_H
+#define INCLUDED_PROFILE_H
+
+/*
+ * Timed phases of a frame
+ */
+enum
+{
+    PROF_NET_INPUT = 0,     /* Net_input() */
+    PROF_MONSTERS_PRE,      /* process_monsters() before the players */
+    PROF_PLAYERS,           /* process_player() */
+    PROF_MONSTERS_POST,     /* process_monsters() after the players */
+    PROF_WORLD,             /* process_world() */
+    PROF_REFRESH,           /* refresh_stuff() */
+    PROF_NET_OUTPUT,        /* Net_output() */
+    PROF_GENERATE,          /* generate_new_level() */
+    PROF_SAVE,              /* Periodic saves */
+    PROF_VIEW,              /* update_view() */
+    PROF_PROJECT,           /* project() */
+
+    PROF_MAX
+};
+
+/*
+ * Event counters
+ */
+enum
+{
+    PROF_DICE_HIT = 0,      /* effect_simple() dice cache */
+    PROF_DICE_MISS,
+    PROF_MAP_FULL,          /* Main map lines sent in full */
+    PROF_MAP_DELTA,         /* Main map lines sent as deltas */
+    PROF_MAP_SKIPPED,       /* Main map lines not sent (unchanged) */
+    PROF_MAP_GRIDS,         /* Main map grids sent in PKT_CHARS */
+    PROF_MAP_PACKETS,       /* PKT_CHARS packets */
+    PROF_GLYPH_HIT,         /* Per-player glyph cache */
+    PROF_GLYPH_MISS,
+    PROF_PATH_HIT,          /* Projection path cache */
+    PROF_PATH_MISS,
+
+    PROF_COUNTER_MAX
+};
+
+/*
+ * Statistics of a phase over the rolling window (phase = PROF_MAX for whole frames)
+ */
+struct prof_stats
+{
+    uint32_t frames;    /* Frames in the window */
+    uint32_t active;    /* Frames where the phase ran */
+    uint32_t calls;     /* Number of calls */
+    uint64_t usecs;     /* Total time */
+    uint32_t p50;       /* Median time per active frame (upper bound of the bucket) */
+    uint32_t p99;       /* 99th percentile time per active frame (upper bound of the bucket) */
+    uint32_t max;       /* Longest time per frame */
+    uint32_t overruns;  /* Frames over budget (whole frames only) */
+};
+
+extern uint64_t prof_clock(void);
+extern void prof_account(int phase, uint64_t start);
+extern void prof_begin_frame(void);
+extern void prof_end_frame(void);
+extern const char *prof_name(int phase);
+extern int prof_window_secs(void);
+extern void prof_window(int phase, struct prof_stats *stats);
+extern void prof_totals(int phase, uint64_t *usecs, uint32_t *calls, uint32_t *overruns);
+extern void prof_reset(void);
+extern bool prof_overloaded(void);
+extern void prof_late(uint32_t caught_up, uint32_t dropped);
+extern void prof_shed(void);
+extern void prof_sched_totals(uint32_t *late, uint32_t *caught_up, uint32_t *dropped,
+    uint32_t *shed);
+extern void prof_count(int counter, uint32_t n);
+extern uint32_t prof_counter(int counter);
+extern double prof_counter_rate(int counter);
+
+#endif /* INCLUDED_PROFILE_H */
@@ -76,47 +76,15 @@ const char *proj_idx_to_name(int type)
 
 
 /*
- * Determine the path taken by a projection.
- *
- * The projection will always start from grid1, and will travel
- * towards grid2, touching one grid per unit of distance along
- * the major axis, and stopping when it enters the finish grid or a
- * wall grid, or has travelled the maximum legal distance of "range".
- *
- * Note that "distance" in this function (as in the "update_view()" code)
- * is defined as "MAX(dy,dx) + MIN(dy,dx)/2", which means that the player
- * actually has an "octagon of projection" not a "circle of projection".
- *
- * The path grids are saved into the grid array pointed to by "gp", and
- * there should be room for at least "range" grids in "gp".  Note that
- * due to the way in which distance is calculated, this function normally
- * uses fewer than "range" grids for the projection path, so the result
- * of this function should never be compared directly to "range".  Note
- * that the initial grid is never saved into the grid array, not
- * even if the initial grid is also the final grid.  XXX XXX XXX
- *
- * The "flg" flags can be used to modify the behavior of this function.
- *
- * In particular, the "PROJECT_STOP" and "PROJECT_THRU" flags have the same
- * semantics as they do for the "project" function, namely, that the path
- * will stop as soon as it hits a monster, or that the path will continue
- * through the finish grid, respectively.
+ * Walk the path of a projection, see project_path()
  *
- * The "PROJECT_JUMP" flag, which for the "project()" function means to
- * start at a special grid (which makes no sense in this function), means
- * that the path should be "angled" slightly if needed to avoid any wall
- * grids, allowing the player to "target" any grid which is in "view".
- *
- * This function returns the number of grids (if any) in the path.  This
- * function will return zero if and only if grid1 and grid2 are equal.
- *
- * This algorithm is similar to, but slightly different from, the one used
- * by "update_view_los()", and very different from the one used by "los()".
+ * The path grids are saved into "gp" (unless NULL), the last one into "last" (unless NULL).
  */
-int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, struct loc *grid1,
-    struct loc *grid2, int flg)
+static int project_path_aux(struct player *p, struct chunk *c, struct loc *gp, int range,
+    struct loc *grid1, struct loc *grid2, int flg, struct loc *last)
 {
     int y, x;
+    struct loc cur;
     int n = 0;
     int k = 0;
 
@@ -185,7 +153,8 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
         while (1)
         {
             /* Save grid */
-            loc_init(&gp[n], x, y);
+            loc_init(&cur, x, y);
+            if (gp) loc_copy(&gp[n], &cur);
             n++;
 
             /* Check maximum range */
@@ -194,7 +163,7 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
             /* Sometimes stop at finish grid */
             if (!(flg & (PROJECT_THRU)))
             {
-                if (loc_eq(&gp[n - 1], grid2)) break;
+                if (loc_eq(&cur, grid2)) break;
             }
 
             /* Don't stop if making paths through rock for generation */
@@ -203,16 +172,16 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
                 /* Stop at non-initial wall grids, except where that would leak info during targeting */
                 if (!(flg & (PROJECT_INFO)))
                 {
-                    if ((n > 0) && !square_isprojectable(c, &gp[n - 1])) break;
+                    if ((n > 0) && !square_isprojectable(c, &cur)) break;
                 }
                 else
-                    if ((n > 0) && p && square_isbelievedwall(p, c, &gp[n - 1])) break;
+                    if ((n > 0) && p && square_isbelievedwall(p, c, &cur)) break;
             }
 
             /* Sometimes stop at non-initial targets */
             if (flg & (PROJECT_STOP))
             {
-                if ((n > 0) && square(c, &gp[n - 1])->mon) break;
+                if ((n > 0) && square(c, &cur)->mon) break;
             }
 
             /* Slant */
@@ -257,7 +226,8 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
         while (1)
         {
             /* Save grid */
-            loc_init(&gp[n], x, y);
+            loc_init(&cur, x, y);
+            if (gp) loc_copy(&gp[n], &cur);
             n++;
 
             /* Check maximum range */
@@ -266,7 +236,7 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
             /* Sometimes stop at finish grid */
             if (!(flg & (PROJECT_THRU)))
             {
-                if (loc_eq(&gp[n - 1], grid2)) break;
+                if (loc_eq(&cur, grid2)) break;
             }
 
             /* Don't stop if making paths through rock for generation */
@@ -275,16 +245,16 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
                 /* Stop at non-initial wall grids, except where that would leak info during targeting */
                 if (!(flg & (PROJECT_INFO)))
                 {
-                    if ((n > 0) && !square_isprojectable(c, &gp[n - 1])) break;
+                    if ((n > 0) && !square_isprojectable(c, &cur)) break;
                 }
                 else
-                    if ((n > 0) && p && square_isbelievedwall(p, c, &gp[n - 1])) break;
+                    if ((n > 0) && p && square_isbelievedwall(p, c, &cur)) break;
             }
 
             /* Sometimes stop at non-initial targets */
             if (flg & (PROJECT_STOP))
             {
-                if ((n > 0) && square(c, &gp[n - 1])->mon) break;
+                if ((n > 0) && square(c, &cur)->mon) break;
             }
 
             /* Slant */
@@ -323,7 +293,8 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
         while (1)
         {
             /* Save grid */
-            loc_init(&gp[n], x, y);
+            loc_init(&cur, x, y);
+            if (gp) loc_copy(&gp[n], &cur);
             n++;
 
             /* Check maximum range */
@@ -332,7 +303,7 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
             /* Sometimes stop at finish grid */
             if (!(flg & (PROJECT_THRU)))
             {
-                if (loc_eq(&gp[n - 1], grid2)) break;
+                if (loc_eq(&cur, grid2)) break;
             }
 
             /* Don't stop if making paths through rock for generation */
@@ -341,16 +312,16 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
                 /* Stop at non-initial wall grids, except where that would leak info during targeting */
                 if (!(flg & (PROJECT_INFO)))
                 {
-                    if ((n > 0) && !square_isprojectable(c, &gp[n - 1])) break;
+                    if ((n > 0) && !square_isprojectable(c, &cur)) break;
                 }
                 else
-                    if ((n > 0) && p && square_isbelievedwall(p, c, &gp[n - 1])) break;
+                    if ((n > 0) && p && square_isbelievedwall(p, c, &cur)) break;
             }
 
             /* Sometimes stop at non-initial targets */
             if (flg & (PROJECT_STOP))
             {
-                if ((n > 0) && square(c, &gp[n - 1])->mon) break;
+                if ((n > 0) && square(c, &cur)->mon) break;
             }
 
             /* Advance (Y) */
@@ -361,11 +332,153 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
         }
     }
 
+    /* Last grid */
+    if (last) loc_copy(last, &cur);
+
     /* Length */
     return (n);
 }
 
 
+
+
+/*
+ * Projection paths are cached per level, since the same paths are often computed many times
+ * during a turn (a monster checks if it can cast a spell, then casts it; a player targets a
+ * monster, then fires at it...). The paths are cached without PROJECT_STOP (monsters move all
+ * the time), which is applied on the cached path instead. A terrain change on the level
+ * (see square_set_feat()) invalidates all the paths of the level.
+ */
+
+
+/* Number of cached paths per level */
+#define PATH_CACHE_SIZE 64
+
+/* Only paths with a shorter range are cached */
+#define PATH_CACHE_LEN  32
+
+
+struct path_cache_entry
+{
+    struct loc grid1;
+    struct loc grid2;
+    int16_t range;
+    int flg;
+    int16_t n;
+    uint32_t feat_changes;
+    struct loc path[PATH_CACHE_LEN];
+};
+
+
+/*
+ * Find a path in the cache, computing it if necessary
+ *
+ * Returns NULL if the path can't be cached.
+ */
+static struct path_cache_entry *path_cache_get(struct chunk *c, int range, struct loc *grid1,
+    struct loc *grid2, int flg)
+{
+    struct path_cache_entry *entry;
+    uint32_t hash;
+
+    /* Level is being generated, path is too long or uses the believed map */
+    if (ht_zero(&c->generated) || (range > PATH_CACHE_LEN) || (flg & PROJECT_INFO)) return NULL;
+
+    /* Only these flags change the path (PROJECT_STOP is applied by the caller) */
+    flg &= (PROJECT_THRU | PROJECT_ROCK);
+
+    if (!c->path_cache) c->path_cache = mem_zalloc(PATH_CACHE_SIZE * sizeof(*entry));
+
+    hash = (uint32_t)(grid1->y * 7919 + grid1->x * 977 + grid2->y * 131 + grid2->x * 31 + range);
+    entry = &c->path_cache[hash % PATH_CACHE_SIZE];
+
+    /* Found it */
+    if (entry->n && (entry->feat_changes == c->feat_changes) && (entry->range == range) &&
+        (entry->flg == flg) && loc_eq(&entry->grid1, grid1) && loc_eq(&entry->grid2, grid2))
+    {
+        prof_count(PROF_PATH_HIT, 1);
+        return entry;
+    }
+
+    /* Compute the path */
+    prof_count(PROF_PATH_MISS, 1);
+    entry->n = (int16_t)project_path_aux(NULL, c, entry->path, range, grid1, grid2, flg, NULL);
+    loc_copy(&entry->grid1, grid1);
+    loc_copy(&entry->grid2, grid2);
+    entry->range = (int16_t)range;
+    entry->flg = flg;
+    entry->feat_changes = c->feat_changes;
+
+    /* No path */
+    if (!entry->n) return NULL;
+
+    return entry;
+}
+
+
+/*
+ * Determine the path taken by a projection.
+ *
+ * The projection will always start from grid1, and will travel
+ * towards grid2, touching one grid per unit of distance along
+ * the major axis, and stopping when it enters the finish grid or a
+ * wall grid, or has travelled the maximum legal distance of "range".
+ *
+ * Note that "distance" in this function (as in the "update_view()" code)
+ * is defined as "MAX(dy,dx) + MIN(dy,dx)/2", which means that the player
+ * actually has an "octagon of projection" not a "circle of projection".
+ *
+ * The path grids are saved into the grid array pointed to by "gp", and
+ * there should be room for at least "range" grids in "gp".  Note that
+ * due to the way in which distance is calculated, this function normally
+ * uses fewer than "range" grids for the projection path, so the result
+ * of this function should never be compared directly to "range".  Note
+ * that the initial grid is never saved into the grid array, not
+ * even if the initial grid is also the final grid.  XXX XXX XXX
+ *
+ * The "flg" flags can be used to modify the behavior of this function.
+ *
+ * In particular, the "PROJECT_STOP" and "PROJECT_THRU" flags have the same
+ * semantics as they do for the "project" function, namely, that the path
+ * will stop as soon as it hits a monster, or that the path will continue
+ * through the finish grid, respectively.
+ *
+ * The "PROJECT_JUMP" flag, which for the "project()" function means to
+ * start at a special grid (which makes no sense in this function), means
+ * that the path should be "angled" slightly if needed to avoid any wall
+ * grids, allowing the player to "target" any grid which is in "view".
+ *
+ * This function returns the number of grids (if any) in the path.  This
+ * function will return zero if and only if grid1 and grid2 are equal.
+ *
+ * This algorithm is similar to, but slightly different from, the one used
+ * by "update_view_los()", and very different from the one used by "los()".
+ */
+int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, struct loc *grid1,
+    struct loc *grid2, int flg)
+{
+    struct path_cache_entry *entry;
+    int n, i;
+
+    /* Get the path from the cache */
+    entry = path_cache_get(c, range, grid1, grid2, flg);
+    if (!entry) return project_path_aux(p, c, gp, range, grid1, grid2, flg, NULL);
+    n = entry->n;
+    memcpy(gp, entry->path, n * sizeof(struct loc));
+
+    /* Sometimes stop at non-initial targets */
+    if (flg & PROJECT_STOP)
+    {
+        for (i = 0; i < n; i++)
+        {
+            if (square(c, &gp[i])->mon) return i + 1;
+        }
+    }
+
+    return n;
+}
+
+
 /*
  * Determine if a bolt spell cast from grid1 to grid2 will arrive
  * at the final destination, assuming that no monster gets in the way,
@@ -382,30 +495,111 @@ int project_path(struct player *p, struct chunk *c, struct loc *gp, int range, s
 bool projectable(struct player *p, struct chunk *c, struct loc *grid1, struct loc *grid2, int flg,
     bool nowall)
 {
-    struct loc grid_g[512];
-    int grid_n = 0;
+    struct path_cache_entry *entry;
+    struct loc last;
     int max_range = z_info->max_range;
 
     /* Check for shortened projection range */
     if ((flg & PROJECT_SHORT) && p && p->timed[TMD_COVERTRACKS]) max_range /= 4;
 
-    /* Check the projection path */
-    grid_n = project_path(NULL, c, grid_g, max_range, grid1, grid2, flg);
+    /* Check the projection path (the path itself is not needed, only its last grid) */
+    entry = path_cache_get(c, max_range, grid1, grid2, flg);
+    if (entry)
+    {
+        int i;
+
+        loc_copy(&last, &entry->path[entry->n - 1]);
+
+        /* Sometimes stop at non-initial targets */
+        if (flg & PROJECT_STOP)
+        {
+            for (i = 0; i < entry->n; i++)
+            {
+                if (square(c, &entry->path[i])->mon)
+                {
+                    loc_copy(&last, &entry->path[i]);
+                    break;
+                }
+            }
+        }
+    }
 
     /* No grid is ever projectable from itself */
-    if (!grid_n) return false;
+    else if (!project_path_aux(NULL, c, NULL, max_range, grid1, grid2, flg, &last)) return false;
 
     /* May not end in a wall grid */
-    if (nowall && !square_ispassable(c, &grid_g[grid_n - 1])) return false;
+    if (nowall && !square_ispassable(c, &last)) return false;
 
     /* May not end in an unrequested grid */
-    if (!loc_eq(&grid_g[grid_n - 1], grid2)) return false;
+    if (!loc_eq(&last, grid2)) return false;
 
     /* Assume okay */
     return true;
 }
 
 
+/*
+ * Scratch buffers for project()
+ *
+ * project() needs a few arrays to store the projection path and the blast area. They are too
+ * big for the stack and used to be allocated on each call, so they are kept on a free list
+ * instead. project() can be called recursively (a monster exploding when killed...), hence the
+ * list: each nested call gets its own set of buffers.
+ *
+ * Each thread has its own free list, so no locking is needed.
+ */
+struct project_scratch
+{
+    struct loc path_grid[512];          /* Actual grids in the "path" */
+    struct loc blast_grid[256];         /* Coordinates of the affected grids */
+    int distance_to_grid[256];          /* Distance to each of the affected grids */
+    int *dam_at_dist;                   /* Precalculated damage values for each distance */
+    bool drawing[MAX_PLAYERS + 1];      /* Players who can see the projection */
+    struct project_scratch *next;       /* Next buffers in the free list */
+};
+
+
+static THREAD_LOCAL struct project_scratch *project_scratch_free;
+
+
+static struct project_scratch *project_scratch_get(void)
+{
+    struct project_scratch *scratch = project_scratch_free;
+
+    if (scratch) project_scratch_free = scratch->next;
+    else
+    {
+        scratch = mem_zalloc(sizeof(*scratch));
+        scratch->dam_at_dist = mem_zalloc((z_info->max_range + 1) * sizeof(int));
+    }
+
+    return scratch;
+}
+
+
+static void project_scratch_put(struct project_scratch *scratch)
+{
+    scratch->next = project_scratch_free;
+    project_scratch_free = scratch;
+}
+
+
+/*
+ * Free the project() scratch buffers of the calling thread
+ */
+void free_project_scratch(void)
+{
+    while (project_scratch_free)
+    {
+        struct project_scratch *scratch = project_scratch_free;
+
+        project_scratch_free = scratch->next;
+        mem_free(scratch->dam_at_dist);
+        mem_free(scratch);
+    }
+}
+
+
 /*
  * Get a legal "multi-hued" color for drawing "spells"
  */
@@ -661,29 +855,34 @@ bool project(struct source *origin, int rad, struct chunk *cv, struct loc *finis
     /* Assume the player sees nothing */
     bool notice = false;
 
+    /* Scratch buffers */
+    struct project_scratch *scratch = project_scratch_get();
+
     /* Notify the UI if it can draw this projection */
-    bool drawing[MAX_PLAYERS];
+    bool *drawing = scratch->drawing;
 
     /* Number of grids in the "path" */
     int num_path_grids = 0;
 
     /* Actual grids in the "path" */
-    struct loc path_grid[512];
+    struct loc *path_grid = scratch->path_grid;
 
     /* Number of grids in the "blast area" (including the "beam" path) */
     int num_grids = 0;
 
     /* Coordinates of the affected grids */
-    struct loc blast_grid[256];
+    struct loc *blast_grid = scratch->blast_grid;
 
     /* Distance to each of the affected grids. */
-    int distance_to_grid[256];
+    int *distance_to_grid = scratch->distance_to_grid;
 
     /* Precalculated damage values for each distance. */
-    int *dam_at_dist = mem_alloc((z_info->max_range + 1) * sizeof(*dam_at_dist));
+    int *dam_at_dist = scratch->dam_at_dist;
+
+    uint64_t prof_start = prof_clock();
 
-    /* Assume the player has seen nothing */
-    for (i = 0; i < MAX_PLAYERS; ++i) drawing[i] = false;
+    /* Assume the player has seen nothing (only connected players are checked) */
+    memset(drawing, 0, (NumPlayers + 1) * sizeof(bool));
 
     /* No projection path - jump to target */
     if (flg & PROJECT_JUMP)
@@ -1202,7 +1401,8 @@ bool project(struct source *origin, int rad, struct chunk *cv, struct loc *finis
         sqinfo_off(square(cv, &blast_grid[i])->info, SQUARE_PROJECT);
     }
 
-    mem_free(dam_at_dist);
+    project_scratch_put(scratch);
+    prof_account(PROF_PROJECT, prof_start);
 
     /* Return "something was noticed" */
     return (notice);
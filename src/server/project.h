@@ -90,6 +90,7 @@ extern bool projectable(struct player *p, struct chunk *c, struct loc *grid1, st
     int flg, bool nowall);
 extern uint8_t proj_color(int type);
 extern void origin_get_loc(struct loc *ploc, struct source *origin);
+extern void free_project_scratch(void);
 extern bool project(struct source *origin, int rad, struct chunk *cv, struct loc *finish, int dam,
     int typ, int flg, int degrees_of_arc, uint8_t diameter_of_source, const char *what);
 
@@ -90,11 +90,13 @@
 #include "player-ui.h"
 #include "player-util.h"
 #include "prefs-ui.h"
+#include "profile.h"
 #include "project.h"
 #include "savefile.h"
 #include "sched-win.h"
 #include "score.h"
 #include "score-ui.h"
+#include "soak.h"
 #include "store.h"
 #include "s-util.h"
 #include "target.h"
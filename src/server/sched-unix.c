@@ -132,6 +132,8 @@ static long		timer_freq;	/* rate at which timer ticks. */
 static void		(*timer_handler)(void);
 static time_t		current_time;
 static int		ticks_till_second;
+static uint64_t		frame_period;	/* 1/FPS in microseconds */
+static uint64_t		next_frame;	/* deadline of the next frame */
 
 /*
  * Catch SIGALRM.
@@ -185,6 +187,8 @@ static void setup_timer(void)
     timers_used = timer_ticks;
     time(&current_time);
     ticks_till_second = timer_freq;
+    frame_period = 1000000 / timer_freq;
+    next_frame = prof_clock() + frame_period;
 
     /*
      * Allow the real-time timer to generate SIGALRM signals.
@@ -401,6 +405,53 @@ void remove_input(int fd)
     }
 }
 
+/*
+ * Run the frame(s) due on a timer tick.
+ *
+ * SIGALRM only wakes us up: frames are accounted against a monotonic clock. When frames are
+ * late, they are either run right away, at most cfg_catch_up_frames per tick ("catch up"), or
+ * dropped (cfg_catch_up_frames = 0: "slow time"). A backlog of more than one second of frames
+ * is always dropped.
+ */
+static void run_frames(void)
+{
+    uint64_t now = prof_clock();
+    uint32_t due, burst = 0, dropped = 0;
+
+    /* Ahead of the clock (timer jitter after a burst), wait for the next tick */
+    if (next_frame > now + frame_period) return;
+
+    if (timer_handler) {
+	(*timer_handler)();
+    }
+    next_frame += frame_period;
+
+    /* On time */
+    now = prof_clock();
+    if (now < next_frame) return;
+
+    /* Late: count the frames whose deadline has passed */
+    due = (uint32_t)((now - next_frame) / frame_period) + 1;
+
+    /* Catch up */
+    while (burst < due && burst < (uint32_t)cfg_catch_up_frames) {
+	if (timer_handler) {
+	    (*timer_handler)();
+	}
+	burst++;
+    }
+    next_frame += burst * frame_period;
+    due -= burst;
+
+    /* Slow time, or too far behind */
+    if (!cfg_catch_up_frames || due > (uint32_t)timer_freq) {
+	dropped = due;
+	next_frame += dropped * frame_period;
+    }
+
+    prof_late(burst, dropped);
+}
+
 static int		sched_running;
 
 void stop_sched(void)
@@ -455,10 +506,9 @@ void sched(void)
 	    io_todo = 3;
 	    tvp = &tv;
 
-	    if (timer_handler) {
-		(*timer_handler)();
-	    }
+	    run_frames();
 
+	    /* Missed ticks are accounted for by run_frames() */
 	    do {
 		++timers_used;
 		if (--ticks_till_second <= 0) {
@@ -466,7 +516,7 @@ void sched(void)
 		    current_time++;
 		    timeout_chime();
 		}
-	    } while (timers_used + 1 < timer_ticks);
+	    } while (timers_used < timer_ticks);
 
 	}
 	else {
@@ -0,0 +1,621 @@
+/*
+ * File: soak.c
+ * Purpose: Headless soak benchmark with scripted bot clients
+ *
+ * Copyright (c) 2026 MAngband and PWMAngband Developers
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+
+#include "s-angband.h"
+
+
+/*
+ * The soak benchmark runs a number of scripted bots inside the server process. Each bot talks
+ * to the server over a real loopback TCP connection: it goes through Contact(), sends the same
+ * setup packets as the client and then drives the game with PKT_WALK, PKT_REST, PKT_GO_UP and
+ * PKT_GO_DOWN, so everything goes through the normal Receive_* handlers. The bots never parse
+ * what the server sends back: they only count the bytes and peek at the server side state to
+ * decide what to do next.
+ *
+ * With soak_hounds, a pack of breathing hounds is summoned next to each bot arriving on a
+ * dungeon level, to stress project().
+ *
+ * After soak_frames frames, a report with frame time percentiles, the time spent in the main
+ * hot spots, a micro-benchmark of update_bonuses() and the bandwidth used by each bot is logged
+ * and the server is shut down. Since the bots create real characters, the benchmark should be
+ * run on a scratch copy of the save directory.
+ */
+
+
+/* Default number of frames to run */
+#define SOAK_DEFAULT_SECONDS    60
+
+/* Bots go down to this depth and then bounce between this level and the one above */
+#define SOAK_DEPTH  5
+
+/* Calls to update_bonuses() per character in the report */
+#define SOAK_BONUS_CALLS    2000
+
+/* Hounds summoned with soak_hounds */
+static const char *soak_hound_races[] =
+{
+    "light hound", "dark hound", "fire hound", "cold hound", "energy hound", "acid hound"
+};
+
+/* Bot states */
+enum
+{
+    BOT_IDLE = 0,   /* Not connected */
+    BOT_CONTACT,    /* Waiting for the connection to be set up */
+    BOT_PLAYING     /* Setup packets sent */
+};
+
+
+struct soak_bot
+{
+    char name[NORMAL_WID];      /* Character name */
+    int state;                  /* Connection state */
+    int fd;                     /* Client end of the connection */
+    sockbuf_t wbuf;             /* Outgoing packets */
+    uint32_t lcg;               /* Private RNG state */
+    int wait;                   /* Frames to wait before the next attempt */
+    int keepalive;              /* Frames until the next keepalive */
+    int wander;                 /* Random steps left before heading for the stairs again */
+    struct worldpos wpos;       /* Level the distance map was computed on */
+    int16_t *dist;              /* Distance to the closest stairs (-1 = unreachable) */
+    struct loc last_grid;       /* Position when the last command was sent */
+    bool walked;                /* The last command was a step */
+    uint64_t bytes;             /* Bytes received from the server */
+    int logins;                 /* Number of successful logins */
+};
+
+
+/* Seed for the RNG (0 = random) */
+uint32_t soak_seed = 0;
+
+/* Number of bots (0 = soak benchmark disabled) */
+int soak_bots = 0;
+
+/* Number of frames to run */
+int soak_frames = 0;
+
+/* Size of the hound pack summoned next to the bots on each new level (0 = none) */
+int soak_hounds = 0;
+
+
+static struct soak_bot *bots;
+static struct loc *queue;
+static uint32_t *frame_usecs;
+static int frame_count;
+static uint64_t frame_start;
+static char soak_pass[NORMAL_WID];
+
+
+static uint32_t bot_rand(struct soak_bot *bot, uint32_t m)
+{
+    bot->lcg = bot->lcg * 1103515245 + 12345;
+    return (bot->lcg >> 16) % m;
+}
+
+
+/*
+ * Prepare the bots
+ */
+void soak_init(void)
+{
+    int i;
+
+    if (soak_bots > MAX_PLAYERS) soak_bots = MAX_PLAYERS;
+    if (soak_frames <= 0) soak_frames = SOAK_DEFAULT_SECONDS * cfg_fps;
+
+    /* All the bots connect from the same address */
+    cfg_limit_player_connections = false;
+
+    /* Hashed like the client does, so that existing characters can log in again */
+    my_strcpy(soak_pass, "soak", sizeof(soak_pass));
+    MD5Password(soak_pass);
+
+    bots = mem_zalloc(soak_bots * sizeof(struct soak_bot));
+    frame_usecs = mem_zalloc(soak_frames * sizeof(uint32_t));
+    queue = mem_zalloc(z_info->dungeon_hgt * z_info->dungeon_wid * sizeof(struct loc));
+
+    for (i = 0; i < soak_bots; i++)
+    {
+        struct soak_bot *bot = &bots[i];
+
+        strnfmt(bot->name, sizeof(bot->name), "Soakbot%d", i + 1);
+        bot->fd = -1;
+        bot->lcg = soak_seed + i * 7919;
+        Sockbuf_init(&bot->wbuf, -1, CLIENT_SEND_SIZE, SOCKBUF_WRITE);
+        bot->dist = mem_zalloc(z_info->dungeon_hgt * z_info->dungeon_wid * sizeof(int16_t));
+    }
+
+    plog_fmt("Soak benchmark: %d bots, %d frames, seed %lu", soak_bots, soak_frames,
+        (unsigned long)soak_seed);
+}
+
+
+static void bot_disconnect(struct soak_bot *bot)
+{
+    DgramClose(bot->fd);
+    bot->fd = -1;
+    bot->wbuf.sock = -1;
+    Sockbuf_clear(&bot->wbuf);
+    bot->state = BOT_IDLE;
+    bot->wait = cfg_fps;
+}
+
+
+/*
+ * Read and discard everything the server sent
+ */
+static void bot_drain(struct soak_bot *bot)
+{
+    char buf[8192];
+    int n;
+
+    while ((n = DgramRead(bot->fd, buf, sizeof(buf))) > 0) bot->bytes += n;
+
+    /* Connection closed by the server */
+    if ((n == 0) || ((errno != EWOULDBLOCK) && (errno != EAGAIN) && (errno != EINTR)))
+        bot_disconnect(bot);
+}
+
+
+static connection_t *bot_connection(struct soak_bot *bot)
+{
+    int i;
+
+    for (i = 0; i < MAX_PLAYERS; i++)
+    {
+        connection_t *connp = get_connection(i);
+
+        if ((connp->state == CONN_FREE) || (connp->state == CONN_CONSOLE)) continue;
+        if (connp->nick && !my_stricmp(connp->nick, bot->name)) return connp;
+    }
+
+    return NULL;
+}
+
+
+static void bot_connect(struct soak_bot *bot)
+{
+    bot->fd = CreateClientSocket("127.0.0.1", cfg_tcp_port);
+    if (bot->fd == -1)
+    {
+        bot->wait = cfg_fps;
+        return;
+    }
+    SetSocketNonBlocking(bot->fd, 1);
+    bot->wbuf.sock = bot->fd;
+
+    /* Same handshake as client_init() */
+    Packet_printf(&bot->wbuf, "%hu", (unsigned)CONNTYPE_PLAYER);
+    Packet_printf(&bot->wbuf, "%hu%c", (unsigned)current_version(), (int)beta_version());
+    Packet_printf(&bot->wbuf, "%s%s%s%s", "Soak", "localhost", bot->name, soak_pass);
+
+    bot->state = BOT_CONTACT;
+    bot->wait = 10 * cfg_fps;
+}
+
+
+/*
+ * Send the setup packets: options, login, character info, start playing
+ */
+static void bot_setup(struct soak_bot *bot)
+{
+    int i;
+
+    Packet_printf(&bot->wbuf, "%b%b", (unsigned)PKT_OPTIONS, 1U);
+    for (i = 0; i < SETTING_MAX; i++)
+    {
+        int16_t value = 0;
+
+        switch (i)
+        {
+            case SETTING_SCREEN_COLS: value = SCREEN_WID; break;
+            case SETTING_SCREEN_ROWS: value = SCREEN_HGT; break;
+            case SETTING_TILE_WID: value = 1; break;
+            case SETTING_TILE_HGT: value = 1; break;
+            case SETTING_MAX_HGT: value = NORMAL_HGT; break;
+        }
+        Packet_printf(&bot->wbuf, "%hd", (int)value);
+    }
+    for (i = 0; i < OPT_MAX; i++)
+        Packet_printf(&bot->wbuf, "%c", (int)option_normal(i));
+
+    Packet_printf(&bot->wbuf, "%b%b", (unsigned)PKT_PLAY, 0U);
+    Packet_printf(&bot->wbuf, "%s%s", bot->name, soak_pass);
+
+    /* Random race, class (except the fake "ghost" class) and sex */
+    /* Ignored if the character already exists */
+    Packet_printf(&bot->wbuf, "%b%b%b%b", (unsigned)PKT_CHAR_INFO,
+        bot_rand(bot, player_rmax()), bot_rand(bot, player_cmax() - 1), bot_rand(bot, MAX_SEXES));
+    for (i = 0; i < STAT_MAX; i++) Packet_printf(&bot->wbuf, "%hd", 0);
+    Packet_printf(&bot->wbuf, "%hd", (int)BR_DEFAULT);
+
+    Packet_printf(&bot->wbuf, "%b%b", (unsigned)PKT_PLAY, 4U);
+
+    bot->state = BOT_PLAYING;
+    bot->wait = 10 * cfg_fps;
+    memset(&bot->wpos, 0, sizeof(bot->wpos));
+}
+
+
+static bool bot_can_cross(struct chunk *c, struct loc *grid)
+{
+    return (square_ispassable(c, grid) || square_iscloseddoor(c, grid) || square_isrubble(c, grid));
+}
+
+
+/*
+ * Compute the distance from each grid to the closest staircase leading in the wanted direction
+ */
+static void bot_find_stairs(struct soak_bot *bot, struct chunk *c, bool down)
+{
+    struct loc begin, end;
+    struct loc_iterator iter;
+    int head = 0, tail = 0;
+
+    loc_init(&begin, 0, 0);
+    loc_init(&end, c->width, c->height);
+    loc_iterator_first(&iter, &begin, &end);
+
+    /* Start from every staircase */
+    do
+    {
+        int16_t *d = &bot->dist[iter.cur.y * c->width + iter.cur.x];
+
+        *d = -1;
+        if (down && !square_isdownstairs(c, &iter.cur)) continue;
+        if (!down && !square_isupstairs(c, &iter.cur)) continue;
+
+        *d = 0;
+        loc_copy(&queue[tail++], &iter.cur);
+    }
+    while (loc_iterator_next_strict(&iter));
+
+    /* Flood the level */
+    while (head < tail)
+    {
+        struct loc *grid = &queue[head++];
+        int16_t d = bot->dist[grid->y * c->width + grid->x];
+        int i;
+
+        for (i = 0; i < 8; i++)
+        {
+            struct loc next;
+            int16_t *nd;
+
+            loc_sum(&next, grid, &ddgrid_ddd[i]);
+            if (!square_in_bounds(c, &next) || !bot_can_cross(c, &next)) continue;
+            nd = &bot->dist[next.y * c->width + next.x];
+            if (*nd != -1) continue;
+
+            *nd = d + 1;
+            loc_copy(&queue[tail++], &next);
+        }
+    }
+}
+
+
+/*
+ * Pick the neighbouring grid closest to the stairs
+ */
+static int bot_step(struct soak_bot *bot, struct player *p, struct chunk *c)
+{
+    int16_t best = bot->dist[p->grid.y * c->width + p->grid.x];
+    int i, dir = 0;
+
+    if (best <= 0) return 0;
+
+    for (i = 1; i < 10; i++)
+    {
+        struct loc grid;
+        int16_t d;
+
+        if (i == 5) continue;
+        loc_sum(&grid, &p->grid, &ddgrid[i]);
+        if (!square_in_bounds(c, &grid)) continue;
+        d = bot->dist[grid.y * c->width + grid.x];
+        if ((d < 0) || (d >= best)) continue;
+
+        best = d;
+        dir = i;
+    }
+
+    return dir;
+}
+
+
+/*
+ * Decide what to do next: fight adjacent monsters, rest when hurt, take the stairs when
+ * standing on them, otherwise walk towards the stairs (or randomly when stuck)
+ */
+static void bot_act(struct soak_bot *bot, connection_t *connp, struct player *p)
+{
+    struct chunk *c = chunk_get(&p->wpos);
+    bool down = (p->wpos.depth < SOAK_DEPTH);
+    int dir = 0, i;
+    struct loc grid;
+
+    /* Keep the connection alive */
+    if (--bot->keepalive <= 0)
+    {
+        Packet_printf(&bot->wbuf, "%b%ld", (unsigned)PKT_KEEPALIVE, (int32_t)frame_count);
+        bot->keepalive = cfg_fps;
+    }
+
+    /* Wait until the last command has been executed */
+    if (!c || connp->q.len || !has_energy(p, false)) return;
+    if (player_is_resting(p) || p->upkeep->running || p->upkeep->new_level_method ||
+        p->upkeep->funeral)
+    {
+        return;
+    }
+
+    /* Leave stores */
+    if (in_store(p))
+    {
+        Packet_printf(&bot->wbuf, "%b", (unsigned)PKT_STORE_LEAVE);
+        return;
+    }
+
+    /* New level: look for stairs */
+    if (!wpos_eq(&bot->wpos, &p->wpos))
+    {
+        memcpy(&bot->wpos, &p->wpos, sizeof(bot->wpos));
+        bot_find_stairs(bot, c, down);
+        bot->wander = 0;
+
+        /* Bring some hounds along */
+        if (soak_hounds && (p->wpos.depth > 0))
+        {
+            const char *name = soak_hound_races[bot_rand(bot, N_ELEMENTS(soak_hound_races))];
+
+            summon_specific_race(p, c, &p->grid, get_race(name), soak_hounds);
+
+            /* Keep the bot alive under the breaths */
+            p->timed[TMD_INVULN] = -1;
+        }
+    }
+
+    /* Fight */
+    for (i = 1; i < 10; i++)
+    {
+        if (i == 5) continue;
+        loc_sum(&grid, &p->grid, &ddgrid[i]);
+        if (!square_in_bounds(c, &grid) || (square(c, &grid)->mon <= 0)) continue;
+        dir = i;
+        break;
+    }
+
+    /* Rest */
+    if (!dir && (p->chp < p->mhp / 2) && !bot_rand(bot, 4))
+    {
+        Packet_printf(&bot->wbuf, "%b%hd", (unsigned)PKT_REST, (int)REST_COMPLETE);
+        bot->walked = false;
+        return;
+    }
+
+    /* Take the stairs */
+    if (!dir && down && square_isdownstairs(c, &p->grid))
+    {
+        Packet_printf(&bot->wbuf, "%b", (unsigned)PKT_GO_DOWN);
+        bot->walked = false;
+        return;
+    }
+    if (!dir && !down && square_isupstairs(c, &p->grid))
+    {
+        Packet_printf(&bot->wbuf, "%b", (unsigned)PKT_GO_UP);
+        bot->walked = false;
+        return;
+    }
+
+    /* Walk */
+    if (!dir)
+    {
+        /* Stuck: wander for a while */
+        if (bot->walked && loc_eq(&p->grid, &bot->last_grid) && !bot->wander)
+            bot->wander = 1 + bot_rand(bot, 8);
+
+        if (!bot->wander) dir = bot_step(bot, p, c);
+        if (!dir)
+        {
+            if (bot->wander) bot->wander--;
+            dir = 1 + bot_rand(bot, 9);
+            if (dir == 5) dir = 6;
+        }
+    }
+
+    loc_copy(&bot->last_grid, &p->grid);
+
+    /* Open doors and clear rubble on the way */
+    loc_sum(&grid, &p->grid, &ddgrid[dir]);
+    bot->walked = !(square_in_bounds(c, &grid) &&
+        (square_iscloseddoor(c, &grid) || square_isrubble(c, &grid)));
+    Packet_printf(&bot->wbuf, "%b%c", (unsigned)(bot->walked? PKT_WALK: PKT_ALTER), dir);
+}
+
+
+/*
+ * Run the bots, then start timing the frame
+ */
+void soak_begin_frame(void)
+{
+    int i;
+
+    for (i = 0; i < soak_bots; i++)
+    {
+        struct soak_bot *bot = &bots[i];
+        connection_t *connp;
+
+        if (bot->fd != -1) bot_drain(bot);
+
+        switch (bot->state)
+        {
+            case BOT_IDLE:
+            {
+                if (bot->wait > 0) bot->wait--;
+                else bot_connect(bot);
+                break;
+            }
+
+            case BOT_CONTACT:
+            {
+                connp = bot_connection(bot);
+                if (connp && (connp->state == CONN_SETUP)) bot_setup(bot);
+                else if (--bot->wait <= 0) bot_disconnect(bot);
+                break;
+            }
+
+            case BOT_PLAYING:
+            {
+                connp = bot_connection(bot);
+                if (connp && (connp->state == CONN_PLAYING) && (connp->id != -1))
+                {
+                    if (bot->wait)
+                    {
+                        bot->logins++;
+                        bot->wait = 0;
+                    }
+                    bot_act(bot, connp, player_get(get_player_index(connp)));
+                }
+                else if (bot->wait && (--bot->wait <= 0)) bot_disconnect(bot);
+                break;
+            }
+        }
+
+        if (bot->fd != -1) Sockbuf_flush(&bot->wbuf);
+    }
+
+    frame_start = prof_clock();
+}
+
+
+/*
+ * Record the frame time; log the report and shut down after the last frame
+ */
+void soak_end_frame(void)
+{
+    uint64_t usecs = prof_clock() - frame_start;
+
+    frame_usecs[frame_count++] = (uint32_t)MIN(usecs, 0xFFFFFFFF);
+    if (frame_count < soak_frames) return;
+
+    soak_report();
+    shutdown_server();
+}
+
+
+/*
+ * Micro-benchmark: time update_bonuses() on the characters in the game
+ */
+static void soak_bench_bonuses(void)
+{
+    uint64_t start, usecs = 0;
+    uint32_t calls = 0;
+    int i, n;
+
+    for (i = 1; i <= NumPlayers; i++)
+    {
+        struct player *p = player_get(i);
+        struct chunk *c = chunk_get(&p->wpos);
+
+        if (!c) continue;
+
+        /* Flush the pending updates first */
+        update_stuff(p, c);
+
+        start = prof_clock();
+        for (n = 0; n < SOAK_BONUS_CALLS; n++)
+        {
+            p->upkeep->update |= PU_BONUS;
+            update_stuff(p, c);
+        }
+        usecs += prof_clock() - start;
+        calls += SOAK_BONUS_CALLS;
+    }
+
+    if (!calls) return;
+    plog_fmt("update_bonuses(): %lu ns per call (%lu calls)", (unsigned long)(usecs * 1000 / calls),
+        (unsigned long)calls);
+}
+
+
+static int cmp_usecs(const void *a, const void *b)
+{
+    uint32_t ua = *(const uint32_t *)a, ub = *(const uint32_t *)b;
+
+    return ((ua > ub) - (ua < ub));
+}
+
+
+void soak_report(void)
+{
+    uint32_t *sorted;
+    uint64_t total = 0;
+    uint32_t budget = 1000000 / cfg_fps;
+    struct mem_counters heap, arena, objs, curse_arrays;
+    int i, overruns = 0;
+    double secs;
+
+    if (!frame_count) return;
+
+    sorted = mem_alloc(frame_count * sizeof(uint32_t));
+    memcpy(sorted, frame_usecs, frame_count * sizeof(uint32_t));
+    sort(sorted, frame_count, sizeof(uint32_t), cmp_usecs);
+    for (i = 0; i < frame_count; i++)
+    {
+        total += sorted[i];
+        if (sorted[i] > budget) overruns++;
+    }
+    secs = (double)frame_count / cfg_fps;
+
+    plog_fmt("Soak: %d frames (%.1f s at %d fps), %d bots, %d hounds, seed %lu", frame_count, secs,
+        cfg_fps, soak_bots, soak_hounds, (unsigned long)soak_seed);
+    plog_fmt("Frame time (us): mean %lu, p50 %lu, p90 %lu, p99 %lu, max %lu, %d over budget",
+        (unsigned long)(total / frame_count), (unsigned long)sorted[frame_count / 2],
+        (unsigned long)sorted[frame_count * 9 / 10], (unsigned long)sorted[frame_count * 99 / 100],
+        (unsigned long)sorted[frame_count - 1], overruns);
+    mem_free(sorted);
+
+    for (i = 0; i < PROF_MAX; i++)
+    {
+        uint64_t usecs;
+        uint32_t calls, dummy;
+
+        prof_totals(i, &usecs, &calls, &dummy);
+        plog_fmt("%s: %lu ms in %lu calls (%lu us per frame)", prof_name(i),
+            (unsigned long)(usecs / 1000), (unsigned long)calls,
+            (unsigned long)(usecs / frame_count));
+    }
+    soak_bench_bonuses();
+
+    mem_get_counters(&heap, &arena);
+    object_pool_counters(&objs, &curse_arrays);
+    plog_fmt("Heap: %lu allocations, %lu live (peak %lu)", (unsigned long)heap.allocs,
+        (unsigned long)heap.live, (unsigned long)heap.peak);
+    plog_fmt("Pools: %lu objects (%lu slabs), %lu curses (%lu slabs)",
+        (unsigned long)objs.allocs, (unsigned long)objs.slabs, (unsigned long)curse_arrays.allocs,
+        (unsigned long)curse_arrays.slabs);
+    plog_fmt("Arenas: %lu square flags (%lu slabs)", (unsigned long)arena.allocs,
+        (unsigned long)arena.slabs);
+
+    for (i = 0; i < soak_bots; i++)
+    {
+        plog_fmt("%s: %d logins, %lu bytes received (%lu bytes/s)", bots[i].name, bots[i].logins,
+            (unsigned long)bots[i].bytes, (unsigned long)(bots[i].bytes / secs));
+    }
+}
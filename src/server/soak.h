@@ -0,0 +1,19 @@
+/*
+ * File: soak.h
+ * Purpose: Headless soak benchmark with scripted bot clients
+ */
+
+#ifndef INCLUDED_SOAK_H
+#define INCLUDED_SOAK_H
+
+extern uint32_t soak_seed;
+extern int soak_bots;
+extern int soak_frames;
+extern int soak_hounds;
+
+extern void soak_init(void);
+extern void soak_begin_frame(void);
+extern void soak_end_frame(void);
+extern void soak_report(void);
+
+#endif /* INCLUDED_SOAK_H */
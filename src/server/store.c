@@ -2882,7 +2882,8 @@ void store_confirm(struct player *p)
     /* Combine the pack (later) */
     p->upkeep->notice |= (PN_COMBINE);
 
-    /* Redraw */
+    /* Redraw (selling prices may have changed) */
+    item_cache_invalidate(p);
     set_redraw_equip(p, NULL);
     set_redraw_inven(p, NULL);
 
@@ -3190,6 +3191,7 @@ void do_cmd_store(struct player *p, int pstore)
         s->max_depth = p->max_depth;
 
         /* Redraw (add selling prices) */
+        item_cache_invalidate(p);
         set_redraw_equip(p, NULL);
         set_redraw_inven(p, NULL);
         handle_stuff(p);
@@ -60,6 +60,53 @@ void text_out_done(struct player *p)
 }
 
 
+/*
+ * Copy of the text written by a text_out_init()/text_out_done() pair
+ */
+struct text_out_copy
+{
+    int16_t lines;
+    int height, width;  /* Size of the window the text was written for */
+    cave_view_type info[][NORMAL_WID];
+};
+
+
+/*
+ * Compare the text written by the last text_out_init()/text_out_done() pair for a window of
+ * the given size with the copy made by the previous call, so that callers can tell whether it
+ * changed since it was last sent. The copy is then updated (and allocated if *copy is NULL).
+ */
+bool text_out_changed(struct player *p, struct text_out_copy **copy, int height, int width)
+{
+    struct text_out_copy *prev = *copy;
+    size_t size = p->last_info_line * sizeof(p->info[0]);
+
+    if (prev && (prev->lines == p->last_info_line) && (prev->height == height) &&
+        (prev->width == width) && !memcmp(prev->info, p->info, size))
+    {
+        return false;
+    }
+
+    prev = *copy = mem_realloc(prev, sizeof(*prev) + size);
+    memcpy(prev->info, p->info, size);
+    prev->lines = p->last_info_line;
+    prev->height = height;
+    prev->width = width;
+
+    return true;
+}
+
+
+/*
+ * Forget a copy made by text_out_changed()
+ */
+void text_out_copy_free(struct text_out_copy **copy)
+{
+    mem_free(*copy);
+    *copy = NULL;
+}
+
+
 /*
  * Write text and apply line-wrapping.
  *
@@ -8,11 +8,16 @@
 
 typedef void (*text_writer)(ang_file *f, void *data);
 
+struct text_out_copy;
+
 extern void text_out_init(struct player *p);
 extern void text_out(struct player *p, const char *fmt, ...);
 extern void text_out_c(struct player *p, uint8_t a, const char *fmt, ...);
 extern void text_out_done(struct player *p);
 extern void text_out_done_no_newline(struct player *p);
+extern bool text_out_changed(struct player *p, struct text_out_copy **copy, int height,
+    int width);
+extern void text_out_copy_free(struct text_out_copy **copy);
 extern errr text_lines_to_file(const char *path, text_writer writer, void *data);
 
 #endif /* INCLUDED_Z_TEXTBLOCK_H */